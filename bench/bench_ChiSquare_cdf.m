@@ -0,0 +1,39 @@
+## Copyright (C) 2026 Karl Wette
+##
+## This program is free software; you can redistribute it and/or modify
+## it under the terms of the GNU General Public License as published by
+## the Free Software Foundation; either version 3 of the License, or
+## (at your option) any later version.
+##
+## This program is distributed in the hope that it will be useful,
+## but WITHOUT ANY WARRANTY; without even the implied warranty of
+## MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+## GNU General Public License for more details.
+##
+## You should have received a copy of the GNU General Public License
+## along with Octave; see the file COPYING.  If not, see
+## <http://www.gnu.org/licenses/>.
+
+
+## -*- texinfo -*-
+## @deftypefn {Function File} {@var{cases} =} bench_ChiSquare_cdf()
+##
+## Benchmark cases for @command{ChiSquare_cdf()}: central and non-central
+## cumulative distribution functions for arrays of varying size and number
+## of degrees of freedom. See @command{make bench}.
+##
+## @end deftypefn
+
+function cases = bench_ChiSquare_cdf()
+  cases = struct("params", {}, "setup", {}, "run", {}, "cleanup", {});
+  for n = [1e3, 1e5]
+    for k = [4, 16]
+      for lambda = [0, 20]
+        cases(end+1).params = struct("n", n, "k", k, "lambda", lambda);
+        cases(end).setup = @() k + lambda + 3*sqrt(2*(k + 2*lambda))*randn(n, 1);
+        cases(end).run = @(x) ChiSquare_cdf(x, k, lambda);
+        cases(end).cleanup = [];
+      endfor
+    endfor
+  endfor
+endfunction
@@ -0,0 +1,39 @@
+## Copyright (C) 2026 Karl Wette
+##
+## This program is free software; you can redistribute it and/or modify
+## it under the terms of the GNU General Public License as published by
+## the Free Software Foundation; either version 3 of the License, or
+## (at your option) any later version.
+##
+## This program is distributed in the hope that it will be useful,
+## but WITHOUT ANY WARRANTY; without even the implied warranty of
+## MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+## GNU General Public License for more details.
+##
+## You should have received a copy of the GNU General Public License
+## along with Octave; see the file COPYING.  If not, see
+## <http://www.gnu.org/licenses/>.
+
+
+## -*- texinfo -*-
+## @deftypefn {Function File} {@var{cases} =} bench_LatticeFindClosestPoint()
+##
+## Benchmark cases for @command{LatticeFindClosestPoint()}: finding the closest
+## lattice points to random points, for varying lattices, dimensions, and
+## numbers of points. See @command{make bench}.
+##
+## @end deftypefn
+
+function cases = bench_LatticeFindClosestPoint()
+  cases = struct("params", {}, "setup", {}, "run", {}, "cleanup", {});
+  for lattice = {"Zn", "Ans"}
+    for dim = [2, 4, 8]
+      for n = [1e4, 1e5]
+        cases(end+1).params = struct("lattice", lattice{1}, "dim", dim, "n", n);
+        cases(end).setup = @() rand(dim, n);
+        cases(end).run = @(x) LatticeFindClosestPoint(x, lattice{1});
+        cases(end).cleanup = [];
+      endfor
+    endfor
+  endfor
+endfunction
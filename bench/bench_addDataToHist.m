@@ -0,0 +1,38 @@
+## Copyright (C) 2026 Karl Wette
+##
+## This program is free software; you can redistribute it and/or modify
+## it under the terms of the GNU General Public License as published by
+## the Free Software Foundation; either version 3 of the License, or
+## (at your option) any later version.
+##
+## This program is distributed in the hope that it will be useful,
+## but WITHOUT ANY WARRANTY; without even the implied warranty of
+## MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+## GNU General Public License for more details.
+##
+## You should have received a copy of the GNU General Public License
+## along with Octave; see the file COPYING.  If not, see
+## <http://www.gnu.org/licenses/>.
+
+
+## -*- texinfo -*-
+## @deftypefn {Function File} {@var{cases} =} bench_addDataToHist()
+##
+## Benchmark cases for @command{addDataToHist()}: adding normally-distributed
+## data of varying size to linear-bin histograms of varying dimension.
+## See @command{make bench}.
+##
+## @end deftypefn
+
+function cases = bench_addDataToHist()
+  cases = struct("params", {}, "setup", {}, "run", {}, "cleanup", {});
+  for n = [1e4, 1e6]
+    for dim = [1, 2, 3]
+      types = repmat({{"lin", "dbin", 0.1}}, 1, dim);
+      cases(end+1).params = struct("n", n, "dim", dim);
+      cases(end).setup = @() struct("hgrm", Hist(dim, types{:}), "data", randn(n, dim));
+      cases(end).run = @(d) addDataToHist(d.hgrm, d.data);
+      cases(end).cleanup = [];
+    endfor
+  endfor
+endfunction
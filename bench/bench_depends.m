@@ -0,0 +1,54 @@
+## Copyright (C) 2026 Karl Wette
+##
+## This program is free software; you can redistribute it and/or modify
+## it under the terms of the GNU General Public License as published by
+## the Free Software Foundation; either version 3 of the License, or
+## (at your option) any later version.
+##
+## This program is distributed in the hope that it will be useful,
+## but WITHOUT ANY WARRANTY; without even the implied warranty of
+## MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+## GNU General Public License for more details.
+##
+## You should have received a copy of the GNU General Public License
+## along with Octave; see the file COPYING.  If not, see
+## <http://www.gnu.org/licenses/>.
+
+
+## -*- texinfo -*-
+## @deftypefn {Function File} {@var{cases} =} bench_depends()
+##
+## Benchmark cases for @command{depends()}: resolving the dependencies of
+## OctApps functions with dependency trees of varying size, with and without
+## excluding the Octave installation. See @command{make bench}.
+##
+## @end deftypefn
+
+function cases = bench_depends()
+  cases = struct("params", {}, "setup", {}, "run", {}, "cleanup", {});
+  if exist("depends") != 3
+    return
+  endif
+  octprefixes = cellfun(@octapps_config_info, {"fcnfiledir", "octfiledir"}, "UniformOutput", false);
+  for func = {"parseOptions", "LatticeMismatchHist", "SqrSNRGeometricFactorHist"}
+    for exclude = [1, 0]
+      cases(end+1).params = struct("function", func{1}, "exclude", exclude);
+      if exclude
+        cases(end).setup = @() octprefixes;
+      else
+        cases(end).setup = @() {};
+      endif
+      cases(end).run = @(prefixes) run_depends(prefixes, func{1});
+      cases(end).cleanup = [];
+    endfor
+  endfor
+endfunction
+
+## depends() requires both output arguments
+function run_depends(prefixes, func)
+  if isempty(prefixes)
+    [deps, extras] = depends(func);
+  else
+    [deps, extras] = depends(prefixes, func);
+  endif
+endfunction
@@ -0,0 +1,66 @@
+## Copyright (C) 2026 Karl Wette
+##
+## This program is free software; you can redistribute it and/or modify
+## it under the terms of the GNU General Public License as published by
+## the Free Software Foundation; either version 3 of the License, or
+## (at your option) any later version.
+##
+## This program is distributed in the hope that it will be useful,
+## but WITHOUT ANY WARRANTY; without even the implied warranty of
+## MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+## GNU General Public License for more details.
+##
+## You should have received a copy of the GNU General Public License
+## along with Octave; see the file COPYING.  If not, see
+## <http://www.gnu.org/licenses/>.
+
+
+## -*- texinfo -*-
+## @deftypefn {Function File} {@var{cases} =} bench_fitsread()
+##
+## Benchmark cases for @command{fitsread()}: reading the FITS file used by
+## the @command{fitsread()} tests, and FITS image files of varying size.
+## See @command{make bench}.
+##
+## @end deftypefn
+
+function cases = bench_fitsread()
+  cases = struct("params", {}, "setup", {}, "run", {}, "cleanup", {});
+  if exist("fitsread") != 3
+    return
+  endif
+  testfile = fullfile(fileparts(file_in_loadpath("fitsread.cc")), "fitsread_test.fits");
+  if exist(testfile, "file")
+    cases(end+1).params = struct("file", "fitsread_test.fits", "rows", 0, "cols", 0);
+    cases(end).setup = @() testfile;
+    cases(end).run = @(fname) fitsread(fname);
+    cases(end).cleanup = [];
+  endif
+  for rows = [1e3, 1e5]
+    cols = 16;
+    cases(end+1).params = struct("file", "image", "rows", rows, "cols", cols);
+    cases(end).setup = @() write_fits_image(randn(rows, cols));
+    cases(end).run = @(fname) fitsread(fname);
+    cases(end).cleanup = @(fname) unlink(fname);
+  endfor
+endfunction
+
+## write a minimal FITS file containing a double-precision image in the primary HDU
+function fname = write_fits_image(data)
+  fname = strcat(tempname(tempdir), ".fits");
+  [rows, cols] = size(data);
+  cards = {sprintf("%-8s= %20s", "SIMPLE", "T"), ...
+           sprintf("%-8s= %20i", "BITPIX", -64), ...
+           sprintf("%-8s= %20i", "NAXIS", 2), ...
+           sprintf("%-8s= %20i", "NAXIS1", cols), ...
+           sprintf("%-8s= %20i", "NAXIS2", rows), ...
+           "END"};
+  header = sprintf("%-80s", cards{:});
+  header(end+1:2880*ceil(length(header) / 2880)) = " ";
+  fid = fopen(fname, "w");
+  assert(fid >= 0, "%s: could not open '%s'", funcName, fname);
+  fwrite(fid, header, "char");
+  fwrite(fid, data.', "double", 0, "ieee-be");
+  fwrite(fid, zeros(1, mod(-8*numel(data), 2880)), "uint8");
+  fclose(fid);
+endfunction
@@ -0,0 +1,42 @@
+## Copyright (C) 2026 Karl Wette
+##
+## This program is free software; you can redistribute it and/or modify
+## it under the terms of the GNU General Public License as published by
+## the Free Software Foundation; either version 3 of the License, or
+## (at your option) any later version.
+##
+## This program is distributed in the hope that it will be useful,
+## but WITHOUT ANY WARRANTY; without even the implied warranty of
+## MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+## GNU General Public License for more details.
+##
+## You should have received a copy of the GNU General Public License
+## along with Octave; see the file COPYING.  If not, see
+## <http://www.gnu.org/licenses/>.
+
+
+## -*- texinfo -*-
+## @deftypefn {Function File} {@var{cases} =} bench_kde()
+##
+## Benchmark cases for @command{kde()} and @command{kdebatch()}: density
+## estimates of a single dataset, and of many datasets at once with varying
+## numbers of threads. See @command{make bench}.
+##
+## @end deftypefn
+
+function cases = bench_kde()
+  cases = struct("params", {}, "setup", {}, "run", {}, "cleanup", {});
+  cases(end+1).params = struct("func", "kde", "ndata", 1e4, "nsets", 1, "threads", 0);
+  cases(end).setup = @() randn(1e4, 1);
+  cases(end).run = @(data) kde(data, 2^14);
+  cases(end).cleanup = [];
+  if exist("kdebatch") != 3
+    return
+  endif
+  for threads = [1, 2, 4]
+    cases(end+1).params = struct("func", "kdebatch", "ndata", 1e4, "nsets", 100, "threads", threads);
+    cases(end).setup = @() randn(1e4, 100);
+    cases(end).run = @(data) kdebatch(data, 2^14, [], [], threads);
+    cases(end).cleanup = [];
+  endfor
+endfunction
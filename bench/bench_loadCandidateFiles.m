@@ -0,0 +1,56 @@
+## Copyright (C) 2026 Karl Wette
+##
+## This program is free software; you can redistribute it and/or modify
+## it under the terms of the GNU General Public License as published by
+## the Free Software Foundation; either version 3 of the License, or
+## (at your option) any later version.
+##
+## This program is distributed in the hope that it will be useful,
+## but WITHOUT ANY WARRANTY; without even the implied warranty of
+## MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+## GNU General Public License for more details.
+##
+## You should have received a copy of the GNU General Public License
+## along with Octave; see the file COPYING.  If not, see
+## <http://www.gnu.org/licenses/>.
+
+
+## -*- texinfo -*-
+## @deftypefn {Function File} {@var{cases} =} bench_loadCandidateFiles()
+##
+## Benchmark cases for @command{loadCandidateFiles()}: loading varying numbers
+## of candidate files with varying numbers of threads. See @command{make bench}.
+##
+## @end deftypefn
+
+function cases = bench_loadCandidateFiles()
+  cases = struct("params", {}, "setup", {}, "run", {}, "cleanup", {});
+  if exist("loadCandidateFiles") != 3
+    return
+  endif
+  for nfiles = [100, 1000]
+    for threads = [1, 2, 4]
+      cases(end+1).params = struct("nfiles", nfiles, "threads", threads);
+      cases(end).setup = @() write_candidate_files(nfiles);
+      cases(end).run = @(fnames) loadCandidateFiles(fnames, threads);
+      cases(end).cleanup = @(fnames) cellfun(@unlink, fnames);
+    endfor
+  endfor
+endfunction
+
+## write candidate files with random values
+function fnames = write_candidate_files(nfiles)
+  fnames = cell(1, nfiles);
+  for i = 1:nfiles
+    fnames{i} = tempname(tempdir);
+    fid = fopen(fnames{i}, "w");
+    assert(fid >= 0, "%s: could not open '%s'", funcName, fnames{i});
+    fprintf(fid, "%% candidate %i\n", i);
+    fprintf(fid, "refTime = %0.9f;\n", 800000000 + 1000*i);
+    fprintf(fid, "Alpha = %0.16g;\nDelta = %0.16g;\n", 2*pi*rand(), pi*(rand() - 0.5));
+    fprintf(fid, "Freq = %0.16g;\nf1dot = %0.16g;\n", 100 + rand(), -1e-10*rand());
+    fprintf(fid, "twoF = %0.16g;\n", 10 + 50*rand());
+    fprintf(fid, "Fa = %0.16g %+0.16gi;\n", randn(), randn());
+    fclose(fid);
+  endfor
+endfunction
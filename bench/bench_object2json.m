@@ -0,0 +1,42 @@
+## Copyright (C) 2026 Karl Wette
+##
+## This program is free software; you can redistribute it and/or modify
+## it under the terms of the GNU General Public License as published by
+## the Free Software Foundation; either version 3 of the License, or
+## (at your option) any later version.
+##
+## This program is distributed in the hope that it will be useful,
+## but WITHOUT ANY WARRANTY; without even the implied warranty of
+## MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+## GNU General Public License for more details.
+##
+## You should have received a copy of the GNU General Public License
+## along with Octave; see the file COPYING.  If not, see
+## <http://www.gnu.org/licenses/>.
+
+## -*- texinfo -*-
+## @deftypefn {Function File} {@var{cases} =} bench_object2json()
+##
+## Benchmark cases for @command{object2json()}: serialising numeric arrays
+## and arrays of structs of varying size, to a string and to a file.
+## See @command{make bench}.
+##
+## @end deftypefn
+
+function cases = bench_object2json()
+  cases = struct("params", {}, "setup", {}, "run", {}, "cleanup", {});
+  for n = [1e2, 1e4]
+    cases(end+1).params = struct("object", "matrix", "size", n, "output", "string");
+    cases(end).setup = @() rand(n / 10, 10);
+    cases(end).run = @(x) object2json(x);
+    cases(end).cleanup = [];
+    cases(end+1).params = struct("object", "struct", "size", n, "output", "string");
+    cases(end).setup = @() struct("a", num2cell(rand(1, n / 10)), "b", "xyz", "c", {{1, 2 + 3i}});
+    cases(end).run = @(x) object2json(x);
+    cases(end).cleanup = [];
+  endfor
+  cases(end+1).params = struct("object", "matrix", "size", 1e4, "output", "file");
+  cases(end).setup = @() {rand(1e3, 10), tempname(tempdir)};
+  cases(end).run = @(x) object2json(x{:});
+  cases(end).cleanup = @(x) unlink(x{2});
+endfunction
@@ -0,0 +1,36 @@
+## Copyright (C) 2026 Karl Wette
+##
+## This program is free software; you can redistribute it and/or modify
+## it under the terms of the GNU General Public License as published by
+## the Free Software Foundation; either version 3 of the License, or
+## (at your option) any later version.
+##
+## This program is distributed in the hope that it will be useful,
+## but WITHOUT ANY WARRANTY; without even the implied warranty of
+## MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+## GNU General Public License for more details.
+##
+## You should have received a copy of the GNU General Public License
+## along with Octave; see the file COPYING.  If not, see
+## <http://www.gnu.org/licenses/>.
+
+
+## -*- texinfo -*-
+## @deftypefn {Function File} {@var{cases} =} bench_rngmed()
+##
+## Benchmark cases for @command{rngmed()}: running medians of random data
+## of varying length and window size. See @command{make bench}.
+##
+## @end deftypefn
+
+function cases = bench_rngmed()
+  cases = struct("params", {}, "setup", {}, "run", {}, "cleanup", {});
+  for n = [1e3, 1e4]
+    for window = [11, 101]
+      cases(end+1).params = struct("n", n, "window", window);
+      cases(end).setup = @() randn(1, n);
+      cases(end).run = @(data) rngmed(data, window);
+      cases(end).cleanup = [];
+    endfor
+  endfor
+endfunction
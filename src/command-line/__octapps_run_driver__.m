@@ -65,16 +65,54 @@
 ##
 ## @end table
 ##
+## To avoid the start-up cost of Octave for each call, a pool of Octave
+## processes may be kept running in the background, which then run calls
+## to @command{octapps_run} through a Unix socket:
+##
+## @table @asis
+##
+## @item octapps_run @verb{|--|}server-start [@samp{n}]
+## Start a server with @samp{n} worker processes (default: number of CPUs).
+##
+## @item octapps_run @verb{|--|}server-stop
+## Stop a running server.
+##
+## @item octapps_run @verb{|--|}server-benchmark @samp{n} @samp{function} @samp{arguments}@dots{}
+## Call @samp{function} @samp{n} times, both through the server and by
+## starting a new Octave, and print the number of calls per second.
+##
+## @end table
+##
+## The server listens on the socket given by the environment variable
+## @env{OCTAPPS_RUN_SERVER}, or if not set on
+## @file{$@{XDG_RUNTIME_DIR@}/octapps_run/octapps_run.sock}, or if
+## @env{XDG_RUNTIME_DIR} is not set on
+## @file{$@{TMPDIR@}/octapps_run-$@{UID@}/octapps_run.sock}. The directory
+## containing the socket must be owned by, and accessible only to, the
+## current user, and the server only accepts calls from the same user.
+## Each call is run with the working directory and environment of the
+## caller, in a process forked for that call only; see
+## @command{__octapps_run_server__()} for details. If no server is running,
+## @command{octapps_run} starts a new Octave for each call, as usual.
+##
+## If the environment variable @env{OCTAPPS_PROF} is set, e.g. to
+## @code{report} or @code{trace=@samp{file}.json}, the call is profiled
+## and the results printed/written on exit; see @command{octapps_prof()}.
+##
 ## @end deftypefn
 
 function __octapps_run_driver__(func, varargin)
 
-  ## horrible hack to prevent Octave memory corruption on exit
+  ## horrible hack to prevent Octave memory corruption on exit;
+  ## only register exit function once, in case the driver is called
+  ## repeatedly by an octapps_run server (see __octapps_run_server__())
+  persistent atexit_registered = false;
   gsl;
-  if exist("atexit") == 5 && exist("swig_exit") == 3
-    global exit_code;
-    exit_code = 1;
+  global exit_code;
+  exit_code = 1;
+  if !atexit_registered && exist("atexit") == 5 && exist("swig_exit") == 3
     atexit("__octapps_clean_exit__");
+    atexit_registered = true;
   endif
 
   ## check input
@@ -229,12 +267,15 @@ function __octapps_run_driver__(func, varargin)
   ## convert arguments to flat cell array of {"name", "value", ...} pairs
   args = {{fieldnames(args){:}; struct2cell(args){:}}{:}};
 
-  ## call function and print output
+  ## call function and print output; profile the call if requested
+  ## by the environment variable OCTAPPS_PROF (see octapps_prof())
+  prof = octapps_prof_scope(strcat("octapps_run:", func));
   if isempty(hprintfuncs) || isempty(hprintfuncs{1})
     feval(hfunc, args{:});
   else
     [out{1:length(hprintfuncs)}] = feval(hfunc, args{:});
   endif
+  clear prof;
 
   ## print output
   for i = 1:length(hprintfuncs)
@@ -0,0 +1,244 @@
+## Copyright (C) 2026 Karl Wette
+##
+## This program is free software; you can redistribute it and/or modify
+## it under the terms of the GNU General Public License as published by
+## the Free Software Foundation; either version 2 of the License, or
+## (at your option) any later version.
+##
+## This program is distributed in the hope that it will be useful,
+## but WITHOUT ANY WARRANTY; without even the implied warranty of
+## MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+## GNU General Public License for more details.
+##
+## You should have received a copy of the GNU General Public License
+## along with with program; see the file COPYING. If not, write to the
+## Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+## MA  02111-1307  USA
+
+## -*- texinfo -*-
+## @deftypefn {Function File} {} __octapps_run_server__ ( @var{socket_path}, @var{num_workers} )
+##
+## Run a pool of @var{num_workers} Octave worker processes, which accept
+## @command{octapps_run} requests on the Unix socket @var{socket_path}.
+## Start the server using @command{octapps_run --server-start}.
+##
+## Modules used by most OctApps functions (@command{gsl}, and @command{lal}
+## and @command{lalpulsar} if available) are loaded once, before the worker
+## processes are forked; each request is then run by calling
+## @command{__octapps_run_driver__()} in an already-initialised interpreter.
+##
+## Each request is run in a process forked from a worker for that request
+## only, so that changes to the working directory, global and persistent
+## variables, and other interpreter state do not carry over between requests.
+## The request is run with the working directory and environment of the
+## client, and with the directories in the client's @env{OCTAVE_PATH} in
+## place of those in the server's. Environment variables which are only read
+## when Octave and its modules start up (@env{LD_LIBRARY_PATH},
+## @env{DYLD_LIBRARY_PATH}, @env{OCTAVE_HOME}, and those starting with
+## @env{LAL}) cannot be applied to an already-running server; if any of these
+## differ between client and server, the request is refused, and
+## @command{octapps_run} instead starts a new Octave.
+##
+## The server only accepts requests from processes run by the same user.
+## @var{socket_path} must be in a directory owned by, and accessible only to,
+## the user running the server.
+##
+## Any worker which exits unexpectedly is restarted. The server exits when
+## @var{socket_path} is removed, e.g. by @command{octapps_run --server-stop}.
+##
+## @end deftypefn
+
+function __octapps_run_server__(socket_path, num_workers)
+
+  ## check input
+  assert(ischar(socket_path));
+  assert(isscalar(num_workers) && num_workers > 0 && mod(num_workers, 1) == 0);
+
+  ## preload modules
+  more off;
+  gsl;
+  for module = {"lal", "lalpulsar"}
+    if exist(module{1})
+      try
+        eval(strcat(module{1}, ";"));
+      catch
+        printf("%s: could not preload module '%s'\n", funcName, module{1});
+      end_try_catch
+    endif
+  endfor
+
+  ## create listening socket
+  fd = octapps_run_socket("listen", socket_path);
+  printf("%s: listening on '%s' with %i workers\n", funcName, socket_path, num_workers);
+
+  ## fork worker processes, and restart any which exit,
+  ## until the socket path is removed
+  master_pid = getpid();
+  pids = zeros(1, num_workers);
+  unwind_protect
+    do
+      for i = find(pids == 0)
+        pid = fork();
+        if pid == 0
+          try
+            worker_loop(fd, socket_path);
+          catch err
+            fprintf(stderr, "error: %s\n", err.message);
+          end_try_catch
+          exit(1);
+        elseif pid < 0
+          error("%s: could not fork worker process", funcName);
+        endif
+        pids(i) = pid;
+      endfor
+      pause(1);
+      do
+        pid = waitpid(-1, WNOHANG);
+        if pid > 0
+          printf("%s: worker process %i has exited; restarting\n", funcName, pid);
+          pids(pids == pid) = 0;
+        endif
+      until pid <= 0
+    until !exist(socket_path, "file")
+  unwind_protect_cleanup
+    if getpid() == master_pid
+      for pid = pids(pids > 0)
+        kill(pid, SIG().TERM);
+        waitpid(pid);
+      endfor
+      octapps_run_socket("close", fd, socket_path);
+      printf("%s: stopped\n", funcName);
+    endif
+  end_unwind_protect
+
+endfunction
+
+## accept requests, and run each in a forked process
+function worker_loop(fd, socket_path)
+  while true
+    req = octapps_run_socket("accept", fd);
+    pid = fork();
+    if pid == 0
+      status = run_request(req, socket_path);
+      octapps_run_socket("finish", req, status);
+      exit(status);
+    endif
+    octapps_run_socket("finish", req);
+    if pid < 0
+      error("%s: could not fork request process", funcName);
+    endif
+    waitpid(pid);
+  endwhile
+endfunction
+
+## run a request, with the working directory and environment of the client
+function status = run_request(req, socket_path)
+  status = 1;
+  try
+
+    ## check server is running, or stop server by removing the socket path
+    if strcmp(req.args{1}, "--server-ping")
+      status = 0;
+      return
+    elseif strcmp(req.args{1}, "--server-stop")
+      unlink(socket_path);
+      status = 0;
+      return
+    endif
+
+    ## refuse request if environment variables which are only read at start-up differ;
+    ## octapps_run then falls back to starting a new Octave
+    server_env = env_struct(req.server_env);
+    client_env = env_struct(req.env);
+    names = union(fieldnames(server_env), fieldnames(client_env));
+    for name = names(cellfun(@is_startup_env, names))'
+      if !isfield(server_env, name{1}) || !isfield(client_env, name{1}) || !strcmp(server_env.(name{1}), client_env.(name{1}))
+        status = 255;
+        return
+      endif
+    endfor
+
+    ## change to working directory of the client
+    cd(req.cwd);
+    rehash();
+
+    ## replace directories in server's OCTAVE_PATH with those in the client's,
+    ## then add any directory containing the function to the Octave path
+    if isfield(server_env, "OCTAVE_PATH")
+      server_dirs = strsplit(server_env.OCTAVE_PATH, pathsep);
+      server_dirs = server_dirs(ismember(server_dirs, strsplit(path(), pathsep)));
+      if !isempty(server_dirs)
+        rmpath(server_dirs{:});
+      endif
+    endif
+    client_dirs = {};
+    if isfield(client_env, "OCTAVE_PATH")
+      client_dirs = strsplit(client_env.OCTAVE_PATH, pathsep);
+    endif
+    client_dirs = client_dirs(cellfun(@(d) !isempty(d) && isdir(d), client_dirs));
+    if !isempty(client_dirs)
+      client_dirs = cellfun(@canonicalize_file_name, client_dirs, "UniformOutput", false);
+      addpath(client_dirs{:}, "-begin");
+    endif
+    [funcdir, funcname] = fileparts(req.args{1});
+    if !isempty(funcdir)
+      addpath(canonicalize_file_name(funcdir), "-begin");
+    endif
+
+    ## run request
+    __octapps_run_driver__(funcname, req.args{2:end});
+    status = 0;
+
+  catch err
+    fprintf(stderr, "error: %s\n", err.message);
+  end_try_catch
+endfunction
+
+## convert a cell array of NAME=VALUE environment strings to a struct
+function env = env_struct(envstrs)
+  env = struct;
+  for i = 1:numel(envstrs)
+    j = min(strfind(envstrs{i}, "="));
+    if j > 1
+      name = envstrs{i}(1:j-1);
+      if isvarname(name)
+        env.(name) = envstrs{i}(j+1:end);
+      endif
+    endif
+  endfor
+endfunction
+
+## environment variables which are only read when Octave and its modules start up
+function startup = is_startup_env(name)
+  startup = strncmp(name, "LAL", 3) || any(strcmp(name, {"LD_LIBRARY_PATH", "DYLD_LIBRARY_PATH", "OCTAVE_HOME"}));
+endfunction
+
+%!test
+%!  if exist("octapps_run_socket") != 3 || isempty(file_in_path(getenv("PATH"), "octapps_run_client"))
+%!    return;
+%!  endif
+%!  [status, dir] = system("mktemp -d");
+%!  assert(status == 0);
+%!  dir = strtrim(dir);
+%!  socket_path = fullfile(dir, "octapps_run.sock");
+%!  server = sprintf("OCTAPPS_RUN_SERVER='%s' octapps_run", socket_path);
+%!  client = sprintf("octapps_run_client '%s'", socket_path);
+%!  unwind_protect
+%!    assert(system([server, " --server-start 1"]), 0);
+%!    ## successful call, run through the server
+%!    [status, output] = system([client, " __test_parseOptions__ --real-strictpos-scalar 1.23 --integer-vector='[3,9,5]' --string 'Hi there' --cell '{1,{2,3}}'"]);
+%!    assert(status == 0);
+%!    assert(strtrim(output), 'struct("cell",{{1,{2,3}}},"twobytwo",{[1 0;0 1]},"real_strictpos_scalar",{1.23},"integer_vector",{[3 9 5]},"string",{"Hi there"})')
+%!    ## failed call returns exit status 1
+%!    status = system([client, " __test_parseOptions__ --real-strictpos-scalar -1 --integer-vector='[3,9,5]' --string 'Hi there' --cell '{1,{2,3}}' 2>/dev/null"]);
+%!    assert(status == 1);
+%!    ## calls whose start-up environment differs from the server are refused
+%!    status = system(["LAL_OCTAPPS_RUN_TEST=1 ", client, " __test_parseOptions__ --real-strictpos-scalar 1.23 --integer-vector='[3,9,5]' --string 'Hi there' --cell '{1,{2,3}}'"]);
+%!    assert(status == 255);
+%!    ## after stopping the server, the client reports that there is no server
+%!    assert(system([server, " --server-stop"]), 0);
+%!    assert(system([client, " --server-ping"]), 255);
+%!  unwind_protect_cleanup
+%!    system([server, " --server-stop >/dev/null 2>&1"]);
+%!    system(sprintf("rm -rf '%s'", dir));
+%!  end_unwind_protect
@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2026 Karl Wette
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with with program; see the file COPYING. If not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ * MA  02111-1307  USA
+ */
+
+/*
+ * Client for the octapps_run server mode: sends its working directory,
+ * environment, and command-line arguments, together with its standard input,
+ * output, and error file descriptors, to an octapps_run server listening on a
+ * Unix socket, and exits with the exit status of the request. Servers run by
+ * other users are refused. See octapps_run_socket.cc for a description of the
+ * protocol.
+ *
+ * Usage: octapps_run_client <socket path> <function> <arguments>...
+ *
+ * Exits with status OCTAPPS_RUN_NO_SERVER if no server is listening on the
+ * socket, in which case octapps_run falls back to starting a new Octave.
+ */
+
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+extern char **environ;
+
+#define OCTAPPS_RUN_MAGIC 0x4f415254
+#define OCTAPPS_RUN_NO_SERVER 255
+#define OCTAPPS_RUN_FAILED 254
+
+static int write_all(int fd, const char *buf, size_t n) {
+  while (n > 0) {
+    ssize_t m = write(fd, buf, n);
+    if (m < 0 && errno == EINTR) {
+      continue;
+    }
+    if (m <= 0) {
+      return 0;
+    }
+    buf += m;
+    n -= m;
+  }
+  return 1;
+}
+
+/* Get the user ID of the process at the other end of a Unix socket */
+static int peer_uid(int sock, uid_t *uid) {
+#if defined(SO_PEERCRED)
+  struct ucred cred;
+  socklen_t len = sizeof(cred);
+  if (getsockopt(sock, SOL_SOCKET, SO_PEERCRED, &cred, &len) != 0 || len != sizeof(cred)) {
+    return 0;
+  }
+  *uid = cred.uid;
+#else
+  gid_t gid;
+  if (getpeereid(sock, uid, &gid) != 0) {
+    return 0;
+  }
+#endif
+  return 1;
+}
+
+int main(int argc, char *argv[]) {
+
+  /* Check command line */
+  if (argc < 3) {
+    fprintf(stderr, "Usage: %s <socket path> <function> <arguments>...\n", argv[0]);
+    return OCTAPPS_RUN_FAILED;
+  }
+
+  /* Connect to server; if there is no server, exit silently */
+  struct sockaddr_un addr;
+  memset(&addr, 0, sizeof(addr));
+  if (strlen(argv[1]) >= sizeof(addr.sun_path)) {
+    return OCTAPPS_RUN_NO_SERVER;
+  }
+  addr.sun_family = AF_UNIX;
+  strncpy(addr.sun_path, argv[1], sizeof(addr.sun_path) - 1);
+  int sock = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (sock < 0 || connect(sock, (struct sockaddr*) &addr, sizeof(addr)) != 0) {
+    return OCTAPPS_RUN_NO_SERVER;
+  }
+
+  /* Refuse to send anything to a server which is not run by the same user */
+  uid_t uid;
+  if (!peer_uid(sock, &uid) || uid != getuid()) {
+    fprintf(stderr, "%s: server on '%s' is not run by the current user; refusing to use it\n", argv[0], argv[1]);
+    return OCTAPPS_RUN_FAILED;
+  }
+
+  /* Build request: working directory, followed by environment, followed by arguments */
+  char cwd[PATH_MAX];
+  if (getcwd(cwd, sizeof(cwd)) == NULL) {
+    fprintf(stderr, "%s: could not get working directory: %s\n", argv[0], strerror(errno));
+    return OCTAPPS_RUN_FAILED;
+  }
+  size_t len = strlen(cwd) + 1;
+  uint32_t nenv = 0;
+  for (char **e = environ; e != NULL && *e != NULL; ++e, ++nenv) {
+    len += strlen(*e) + 1;
+  }
+  for (int i = 2; i < argc; ++i) {
+    len += strlen(argv[i]) + 1;
+  }
+  char *request = malloc(len);
+  if (request == NULL) {
+    fprintf(stderr, "%s: out of memory\n", argv[0]);
+    return OCTAPPS_RUN_FAILED;
+  }
+  char *p = request;
+  strcpy(p, cwd);
+  p += strlen(cwd) + 1;
+  for (uint32_t i = 0; i < nenv; ++i) {
+    strcpy(p, environ[i]);
+    p += strlen(environ[i]) + 1;
+  }
+  for (int i = 2; i < argc; ++i) {
+    strcpy(p, argv[i]);
+    p += strlen(argv[i]) + 1;
+  }
+
+  /* Send header, with standard input, output, and error file descriptors */
+  uint32_t header[3] = { OCTAPPS_RUN_MAGIC, (uint32_t) len, nenv };
+  int fds[3] = { STDIN_FILENO, STDOUT_FILENO, STDERR_FILENO };
+  struct msghdr msg;
+  struct iovec iov;
+  union {
+    struct cmsghdr align;
+    char buf[CMSG_SPACE(sizeof(fds))];
+  } control;
+  memset(&msg, 0, sizeof(msg));
+  memset(&control, 0, sizeof(control));
+  iov.iov_base = header;
+  iov.iov_len = sizeof(header);
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control.buf;
+  msg.msg_controllen = sizeof(control.buf);
+  struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = SOL_SOCKET;
+  cmsg->cmsg_type = SCM_RIGHTS;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(fds));
+  memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+  if (sendmsg(sock, &msg, 0) != (ssize_t) sizeof(header) || !write_all(sock, request, len)) {
+    fprintf(stderr, "%s: could not send request to server: %s\n", argv[0], strerror(errno));
+    return OCTAPPS_RUN_FAILED;
+  }
+  free(request);
+
+  /* Wait for exit status */
+  int32_t status = 0;
+  size_t got = 0;
+  while (got < sizeof(status)) {
+    ssize_t m = read(sock, ((char*) &status) + got, sizeof(status) - got);
+    if (m < 0 && errno == EINTR) {
+      continue;
+    }
+    if (m <= 0) {
+      fprintf(stderr, "%s: connection to server was lost\n", argv[0]);
+      return OCTAPPS_RUN_FAILED;
+    }
+    got += m;
+  }
+  close(sock);
+
+  return status;
+
+}
@@ -0,0 +1,438 @@
+//
+// Copyright (C) 2026 Karl Wette
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with with program; see the file COPYING. If not, write to the
+// Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+// MA  02111-1307  USA
+//
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+#include <octave/oct.h>
+#if OCTAVE_VERSION_HEX >= 0x040200
+#include <octave/interpreter.h>
+#else
+#include <octave/toplev.h>
+#endif
+#include <octave/pager.h>
+#include <octave/Cell.h>
+
+#if OCTAVE_VERSION_HEX <= 0x030204
+#define octave_map Octave_map
+#endif
+
+// Protocol between octapps_run_client and octapps_run_socket():
+//   * the server socket is created in a directory which is accessible only
+//     to its owner, and is itself accessible only to its owner; the client
+//     and server both check that the process at the other end of the
+//     connection has the same user ID, and otherwise drop the connection;
+//   * the client connects to the server socket, and sends a header of three
+//     uint32_t: the magic number OCTAPPS_RUN_MAGIC, the length of the request
+//     which follows, and the number of environment strings in the request;
+//     the header also carries the client's standard input, output, and error
+//     file descriptors, as SCM_RIGHTS ancillary data;
+//   * the client sends the request: a sequence of NUL-terminated strings,
+//     giving the client's working directory, its environment as NAME=VALUE
+//     strings, and the arguments to __octapps_run_driver__();
+//   * the server runs the request, writing any output directly to the
+//     client's file descriptors, and then sends back an int32_t exit status.
+#define OCTAPPS_RUN_MAGIC 0x4f415254
+#define OCTAPPS_RUN_MAX_REQUEST (16*1024*1024)
+
+extern char **environ;
+
+static const char *const octapps_run_socket_usage = "-*- texinfo -*- \n\
+@deftypefn {Loadable Function} {@var{fd} =} octapps_run_socket ( \"listen\", @var{path} )\n\
+@deftypefnx{Loadable Function} {@var{conn} =} octapps_run_socket ( \"accept\", @var{fd} )\n\
+@deftypefnx{Loadable Function} {} octapps_run_socket ( \"finish\", @var{conn}, @var{status} )\n\
+@deftypefnx{Loadable Function} {} octapps_run_socket ( \"finish\", @var{conn} )\n\
+@deftypefnx{Loadable Function} {} octapps_run_socket ( \"close\", @var{fd}, @var{path} )\n\
+\n\
+Low-level Unix socket operations used by the @command{octapps_run} server mode; \
+see @command{__octapps_run_server__()}.\n\
+\n\
+@table @code\n\
+@item listen\n\
+Create a Unix socket listening at @var{path}, and return its file descriptor @var{fd}. \
+The directory containing @var{path} must be owned by the current user, and be accessible \
+only to them; the socket is made accessible only to the current user.\n\
+\n\
+@item accept\n\
+Wait for a connection from @command{octapps_run_client} on @var{fd}, and receive its request; \
+connections from processes of other users are dropped. \
+The standard input, output, and error of Octave are redirected to those of the client, \
+and the environment of Octave is replaced by that of the client. \
+Returns a struct @var{conn} with fields @var{cwd}, the working directory of the client, \
+@var{args}, a cell array of arguments to @command{__octapps_run_driver__()}, \
+and @var{env} and @var{server_env}, cell arrays of the environments of the client and of Octave \
+as @samp{NAME=VALUE} strings.\n\
+\n\
+@item finish\n\
+Flush any output, restore the standard input, output, and error, and the environment, of Octave, \
+send the exit @var{status} (if given) to the client, and close the connection @var{conn}.\n\
+\n\
+@item close\n\
+Close the listening socket @var{fd}, and remove @var{path}.\n\
+@end table\n\
+\n\
+@end deftypefn";
+
+// Read/write exactly 'n' bytes, retrying on interrupts
+static bool read_all(int fd, char *buf, size_t n) {
+  while (n > 0) {
+    ssize_t m = read(fd, buf, n);
+    if (m < 0 && errno == EINTR) {
+      continue;
+    }
+    if (m <= 0) {
+      return false;
+    }
+    buf += m;
+    n -= m;
+  }
+  return true;
+}
+static bool write_all(int fd, const char *buf, size_t n) {
+  while (n > 0) {
+    ssize_t m = write(fd, buf, n);
+    if (m < 0 && errno == EINTR) {
+      continue;
+    }
+    if (m <= 0) {
+      return false;
+    }
+    buf += m;
+    n -= m;
+  }
+  return true;
+}
+
+// Flush all buffered output of Octave and the C/C++ runtime
+static void flush_all(void) {
+  octave_stdout.flush();
+  std::cout.flush();
+  std::cerr.flush();
+  fflush(stdout);
+  fflush(stderr);
+}
+
+// Get the user ID of the process at the other end of a Unix socket
+static bool peer_uid(int sock, uid_t *uid) {
+#if defined(SO_PEERCRED)
+  struct ucred cred;
+  socklen_t len = sizeof(cred);
+  if (getsockopt(sock, SOL_SOCKET, SO_PEERCRED, &cred, &len) != 0 || len != sizeof(cred)) {
+    return false;
+  }
+  *uid = cred.uid;
+#else
+  gid_t gid;
+  if (getpeereid(sock, uid, &gid) != 0) {
+    return false;
+  }
+#endif
+  return true;
+}
+
+// Check that a directory is owned by the current user, and is accessible only to them
+static bool is_private_dir(const std::string& dir) {
+  struct stat st;
+  return lstat(dir.c_str(), &st) == 0 && S_ISDIR(st.st_mode) && st.st_uid == getuid() && (st.st_mode & 077) == 0;
+}
+
+// Get/replace the environment, as NAME=VALUE strings
+static std::vector<std::string> get_environ(void) {
+  std::vector<std::string> env;
+  for (char **e = environ; e != 0 && *e != 0; ++e) {
+    env.push_back(*e);
+  }
+  return env;
+}
+static void set_environ(const std::vector<std::string>& env) {
+  const std::vector<std::string> old_env = get_environ();
+  for (size_t i = 0; i < old_env.size(); ++i) {
+    unsetenv(old_env[i].substr(0, old_env[i].find('=')).c_str());
+  }
+  for (size_t i = 0; i < env.size(); ++i) {
+    const size_t j = env[i].find('=');
+    if (j != std::string::npos && j > 0) {
+      setenv(env[i].substr(0, j).c_str(), env[i].substr(j + 1).c_str(), 1);
+    }
+  }
+}
+
+// Environment of Octave, saved while the environment of a client is in use
+static std::vector<std::string> saved_env;
+static bool have_saved_env = false;
+
+// Receive a request header and the client's file descriptors
+static bool recv_header(int conn, uint32_t header[3], int fds[3]) {
+  struct msghdr msg;
+  struct iovec iov;
+  union {
+    struct cmsghdr align;
+    char buf[CMSG_SPACE(3 * sizeof(int))];
+  } control;
+  memset(&msg, 0, sizeof(msg));
+  memset(&control, 0, sizeof(control));
+  iov.iov_base = header;
+  iov.iov_len = 3 * sizeof(uint32_t);
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control.buf;
+  msg.msg_controllen = sizeof(control.buf);
+  ssize_t m;
+  do {
+    m = recvmsg(conn, &msg, 0);
+  } while (m < 0 && errno == EINTR);
+  if (m != (ssize_t) iov.iov_len) {
+    return false;
+  }
+  struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+  if (cmsg == 0 || cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS || cmsg->cmsg_len != CMSG_LEN(3 * sizeof(int))) {
+    return false;
+  }
+  memcpy(fds, CMSG_DATA(cmsg), 3 * sizeof(int));
+  return true;
+}
+
+DEFUN_DLD( octapps_run_socket, args, nargout, octapps_run_socket_usage ) {
+
+  // Prevent octave from crashing ...
+#if OCTAVE_VERSION_HEX < 0x040400
+  octave_exit = ::_Exit;
+#endif
+
+  // Check input and output
+  if (args.length() < 2 || !args(0).is_string()) {
+    print_usage();
+    return octave_value();
+  }
+  const std::string cmd = args(0).string_value();
+
+  if (cmd == "listen") {
+
+    // Create socket listening at path
+    if (args.length() != 2 || !args(1).is_string()) {
+      error("usage: fd = octapps_run_socket(\"listen\", path)");
+      return octave_value();
+    }
+    const std::string path = args(1).string_value();
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    if (path.length() >= sizeof(addr.sun_path)) {
+      error("socket path '%s' is too long", path.c_str());
+      return octave_value();
+    }
+    const size_t slash = path.rfind('/');
+    const std::string dir = (slash == std::string::npos) ? "." : (slash == 0) ? "/" : path.substr(0, slash);
+    if (!is_private_dir(dir)) {
+      error("directory '%s' containing socket must be owned by, and accessible only to, the current user", dir.c_str());
+      return octave_value();
+    }
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+      error("could not create socket: %s", strerror(errno));
+      return octave_value();
+    }
+    const mode_t old_umask = umask(077);
+    const int bind_status = bind(fd, (struct sockaddr*) &addr, sizeof(addr));
+    const int bind_errnum = errno;
+    umask(old_umask);
+    if (bind_status != 0 || chmod(path.c_str(), 0600) != 0 || listen(fd, 64) != 0) {
+      const int errnum = (bind_status != 0) ? bind_errnum : errno;
+      close(fd);
+      error("could not listen on socket '%s': %s", path.c_str(), strerror(errnum));
+      return octave_value();
+    }
+    return octave_value(fd);
+
+  } else if (cmd == "accept") {
+
+    // Wait for a connection, retrying on interrupts (while allowing Octave to handle them)
+    if (args.length() != 2 || !args(1).is_real_scalar()) {
+      error("usage: conn = octapps_run_socket(\"accept\", fd)");
+      return octave_value();
+    }
+    const int fd = args(1).int_value();
+    int conn = -1, fds[3] = {-1, -1, -1};
+    size_t nenv = 0;
+    std::vector<char> request;
+    while (true) {
+      conn = accept(fd, 0, 0);
+      if (conn < 0) {
+        if (errno == EINTR || errno == ECONNABORTED) {
+          octave_quit();
+          continue;
+        }
+        error("could not accept connection: %s", strerror(errno));
+        return octave_value();
+      }
+
+      // Check that the client is run by the same user, then receive request header
+      // and client file descriptors, then the request; connections from other users,
+      // and malformed requests, are dropped, and the server waits for another connection
+      uid_t uid;
+      uint32_t header[3] = {0, 0, 0};
+      if (peer_uid(conn, &uid) && uid == getuid() && recv_header(conn, header, fds) && header[0] == OCTAPPS_RUN_MAGIC && header[1] <= OCTAPPS_RUN_MAX_REQUEST) {
+        request.resize(header[1]);
+        if (read_all(conn, request.data(), request.size()) && !request.empty() && request.back() == '\0') {
+          nenv = header[2];
+          break;
+        }
+      }
+      for (int i = 0; i < 3; ++i) {
+        if (fds[i] >= 0) {
+          close(fds[i]);
+          fds[i] = -1;
+        }
+      }
+      close(conn);
+    }
+
+    // Split request into working directory, environment, and arguments
+    std::vector<std::string> strs;
+    for (size_t i = 0; i < request.size(); i += strs.back().length() + 1) {
+      strs.push_back(std::string(&request[i]));
+    }
+    nenv = std::min(nenv, strs.size() - 1);
+    const std::vector<std::string> env(strs.begin() + 1, strs.begin() + 1 + nenv);
+    octave_map req(dim_vector(1, 1));
+    req.contents("cwd") = Cell(octave_value(strs[0]));
+    Cell reqargs(1, strs.size() - 1 - nenv);
+    for (size_t i = 1 + nenv; i < strs.size(); ++i) {
+      reqargs(i - 1 - nenv) = octave_value(strs[i]);
+    }
+    req.contents("args") = Cell(octave_value(reqargs));
+    Cell client_env(1, env.size());
+    for (size_t i = 0; i < env.size(); ++i) {
+      client_env(i) = octave_value(env[i]);
+    }
+    req.contents("env") = Cell(octave_value(client_env));
+
+    // Replace the environment with that of the client, saving the original
+    // so that it can be restored by "finish"
+    saved_env = get_environ();
+    have_saved_env = true;
+    Cell server_env(1, saved_env.size());
+    for (size_t i = 0; i < saved_env.size(); ++i) {
+      server_env(i) = octave_value(saved_env[i]);
+    }
+    req.contents("server_env") = Cell(octave_value(server_env));
+    set_environ(env);
+
+    // Redirect standard input, output, and error to those of the client,
+    // saving the originals so that they can be restored by "finish"
+    flush_all();
+    int saved[3];
+    for (int i = 0; i < 3; ++i) {
+      saved[i] = dup(i);
+      dup2(fds[i], i);
+      close(fds[i]);
+    }
+    RowVector saved_fds(3);
+    for (int i = 0; i < 3; ++i) {
+      saved_fds(i) = saved[i];
+    }
+    req.contents("conn") = Cell(octave_value(conn));
+    req.contents("saved_fds") = Cell(octave_value(saved_fds));
+    return octave_value(req);
+
+  } else if (cmd == "finish") {
+
+    // Flush output, restore standard input, output, and error, and the environment,
+    // and send exit status if given
+    if (args.length() < 2 || args.length() > 3 || !args(1).is_map() || (args.length() == 3 && !args(2).is_real_scalar())) {
+      error("usage: octapps_run_socket(\"finish\", conn, [status])");
+      return octave_value();
+    }
+    octave_map req = args(1).map_value();
+    const int conn = req.contents("conn")(0).int_value();
+    const NDArray saved = req.contents("saved_fds")(0).array_value();
+    flush_all();
+    for (int i = 0; i < 3; ++i) {
+      dup2((int) saved(i), i);
+      close((int) saved(i));
+    }
+    if (have_saved_env) {
+      set_environ(saved_env);
+      saved_env.clear();
+      have_saved_env = false;
+    }
+    if (args.length() == 3) {
+      const int32_t status = args(2).int_value();
+      write_all(conn, reinterpret_cast<const char*>(&status), sizeof(status));
+    }
+    close(conn);
+    return octave_value_list();
+
+  } else if (cmd == "close") {
+
+    // Close listening socket, and remove its path
+    if (args.length() != 3 || !args(1).is_real_scalar() || !args(2).is_string()) {
+      error("usage: octapps_run_socket(\"close\", fd, path)");
+      return octave_value();
+    }
+    close(args(1).int_value());
+    unlink(args(2).string_value().c_str());
+    return octave_value_list();
+
+  }
+
+  error("unknown command '%s'", cmd.c_str());
+  return octave_value();
+
+}
+
+/*
+
+%!test
+%!  [status, dir] = system("mktemp -d");
+%!  assert(status == 0);
+%!  dir = strtrim(dir);
+%!  path = fullfile(dir, "octapps_run.sock");
+%!  unwind_protect
+%!    fd = octapps_run_socket("listen", path);
+%!    assert(fd >= 0);
+%!    assert(exist(path, "file") > 0);
+%!    [info, err] = lstat(path);
+%!    assert(err == 0);
+%!    assert(bitand(info.mode, 63), 0);   ## no group/other permissions
+%!    octapps_run_socket("close", fd, path);
+%!    assert(exist(path, "file") == 0);
+%!  unwind_protect_cleanup
+%!    rmdir(dir);
+%!  end_unwind_protect
+
+%!error octapps_run_socket("listen", fullfile(tempdir, "octapps_run.sock"))
+
+%!error octapps_run_socket("listen", repmat("x", 1, 1024))
+%!error octapps_run_socket("connect", 0)
+
+*/
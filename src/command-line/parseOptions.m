@@ -19,6 +19,7 @@
 ## @deftypefn {Function File} {} parseOptions ( @var{opts}, @var{optspec}, @var{optspec}, @dots{} )
 ## @deftypefnx{Function File} {@var{paropts} =} parseOptions ( @dots{} )
 ## @deftypefnx{Function File} { [ @bullet{}, @var{paropts} ] =} parseOptions ( @dots{} )
+## @deftypefnx{Function File} {} parseOptions ( "cache", @var{enable} )
 ##
 ## Kitchen-sink options parser.
 ##
@@ -79,6 +80,13 @@
 ## were given as @var{optspec}s; regular options may also be given as
 ## keyword-values.
 ##
+## @item
+## option specifications are compiled once, and cached for subsequent calls
+## with the same option names and types; default values are not cached. The
+## most common type keywords are checked by @command{parseOptionsTypeCheck()},
+## if available. The 4th syntax enables/disables (and clears) the cache, e.g.
+## to measure the overhead of @command{parseOptions()}; see @code{demo parseOptions}.
+##
 ## @end itemize
 ##
 ## @heading Examples
@@ -89,6 +97,22 @@
 
 function varargout = parseOptions(opts, varargin)
 
+  ## cache of compiled option specifications
+  persistent use_cache = true;
+  persistent cache_keys = {};
+  persistent cache_specs = {};
+
+  ## enable/disable cache of compiled option specifications
+  if ischar(opts) && strcmp(opts, "cache")
+    if length(varargin) != 1 || !isscalar(varargin{1})
+      error("%s: expected parseOptions(\"cache\", true|false)", funcName);
+    endif
+    use_cache = logical(varargin{1});
+    cache_keys = {};
+    cache_specs = {};
+    return
+  endif
+
   ## check number of output arguments
   nargoutchk(0, 2);
 
@@ -97,12 +121,244 @@ function varargout = parseOptions(opts, varargin)
     error("%s: expected option specifications in varargin", funcName);
   endif
 
+  ## build key identifying option specifications, excluding default values
+  key = cell(1, length(varargin));
+  for n = 1:length(varargin)
+    optspec = varargin{n};
+    if iscell(optspec) && length(optspec) >= 2 && ischar(optspec{1}) && ischar(optspec{2})
+      key{n} = [optspec{1}, "\t", optspec{2}, "\t", char(48 + length(optspec)), "\n"];
+    elseif !iscell(optspec) && !ischar(optspec) && isempty(optspec)
+      key{n} = "\n";
+    else
+      key{n} = "?\n";
+    endif
+  endfor
+  key = [key{:}];
+
+  ## retrieve compiled option specifications from cache, or compile them
+  i = [];
+  if use_cache
+    i = find(strcmp(key, cache_keys), 1);
+  endif
+  if isempty(i)
+    spec = compile_optspecs(varargin);
+    if use_cache
+      cache_keys{end+1} = key;
+      cache_specs{end+1} = spec;
+    endif
+  else
+    spec = cache_specs{i};
+  endif
+  optchars = spec.optchars;
+  allowed = spec.allowed;
+  required = spec.required;
+  reqnames = spec.reqnames;
+  typefunc = spec.typefunc;
+  typechk = spec.typechk;
+  acceptschar = spec.acceptschar;
+  convfunc = spec.convfunc;
+  noargvalue = spec.noargvalue;
+  atleastone = spec.atleastone;
+  exactlyone = spec.exactlyone;
+  atmostone = spec.atmostone;
+  noneorall = spec.noneorall;
+
+  ## assign default values of optional options, if they're the right type
+  for n = 1:length(spec.defnames)
+    optname = spec.defnames{n};
+    optvalue = varargin{spec.defindex(n)}{3};
+    if !(isempty(optvalue) || check_type(typechk.(optname), typefunc.(optname), optvalue))
+      error("%s: default value of '%s' must be empty or satisfy %s", funcName, optname, formula(typefunc.(optname)));
+    endif
+    paropts.(optname) = optvalue;
+  endfor
+
+  ## list of allowed options
+  allowed_names = fieldnames(allowed);
+
+  ## split function arguments into regular options and keyword-value pairs
+  [regopts, kvopts] = parseparams(opts);
+
+  ## check if there's more regular options than required options
+  if length(regopts) > length(reqnames)
+    error("%s: too many regular arguments, maximum is %i", funcName, length(reqnames))
+  endif
+
+  ## assign regular options in order given by 'reqnames'
+  for n = 1:length(regopts)
+
+    ## assign option value, if it's the right type
+    if !check_type(typechk.(reqnames{n}), typefunc.(reqnames{n}), regopts{n})
+      error("%s: value of '%s' must satisfy %s", funcName, reqnames{n}, formula(typefunc.(reqnames{n})));
+    endif
+    paropts.(reqnames{n}) = regopts{n};
+
+    ## mark that this option has been used
+    --allowed.(reqnames{n});
+    --required.(reqnames{n});
+
+  endfor
+
+  ## check that there's an even number of items in the keyword-value list
+  if mod(length(kvopts), 2) != 0
+    error("%s: expected 'key',value pairs following regular options in args", funcName);
+  endif
+
+  ## assign keyword-value options
+  for n = 1:2:length(kvopts)
+    optkey = kvopts{n};
+    optval = kvopts{n+1};
+
+    ## check that this option is an allowed option
+    if length(optkey) == 1 && isfield(optchars, optkey)
+      optkey = optchars.(optkey);
+    else
+      ii = find(cellfun(@(a_n) strcmp(optkey, a_n), allowed_names));
+      if length(ii) != 1
+        ii = find(cellfun(@(a_n) strncmp(optkey, a_n, min(length(a_n), max(length(optkey), 2))), allowed_names));
+        if length(ii) < 1
+          error("%s: unknown option '%s'", funcName, optkey);
+        endif
+        if length(ii) > 1
+          error("%s: ambiguous option '%s' (matches '%s')", funcName, optkey, strjoin(allowed_names(ii), "' or '"));
+        endif
+      endif
+      optkey = allowed_names{ii};
+    endif
+
+    ## if option does not accept a 'char' value, but option value is a 'char',
+    ## try evaluating it (this is used when parsing arguments from the command line)
+    if ischar(optval) && !isobject(optval) && !accepts_char(acceptschar.(optkey), typefunc.(optkey))
+      try
+        ## convert string expression to number, but evaluate it inside a
+        ## temporary function so that it cannot access local variables
+        eval(sprintf("function x = __tmp__; x = [%s]; endfunction; optval = __tmp__(); clear __tmp__;", optval));
+      catch
+        error("%s: could not create a value from '--%s=%s'", funcName, optkey, optval);
+      end_try_catch
+    endif
+
+    ## special value to indicate argument with no value
+    if isequal(optval, {{}})
+      if isempty(noargvalue.(optkey))
+        error("%s: option '%s' requires an argument", funcName, optkey);
+      endif
+      paropts.(optkey) = noargvalue.(optkey);
+    else
+
+      ## assign option value, if it's the right type
+      if !check_type(typechk.(optkey), typefunc.(optkey), optval)
+
+        ## if option value is empty, use default (i.e. do nothing), otherwise raise error
+        if iscell(optval) || ischar(optval) || !isempty(optval)
+          error("%s: value of '%s' must satisfy %s", funcName, optkey, formula(typefunc.(optkey)));
+        endif
+
+      else
+        paropts.(optkey) = optval;
+      endif
+
+    endif
+
+    ## mark that this option has been used
+    --allowed.(optkey);
+    if isfield(required, optkey)
+      --required.(optkey);
+    endif
+
+  endfor
+
+  ## check that options have been used correctly
+  allnames = fieldnames(allowed);
+  for n = 1:length(allnames)
+
+    ## if allowed < 0, option have been used more than once
+    if allowed.(allnames{n}) < 0
+      error("%s: option '%s' used multiple times", funcName, allnames{n});
+    endif
+
+    if isfield(required, allnames{n})
+
+      ## if required > 0, required option have been used at all
+      if required.(allnames{n}) > 0
+        error("%s: missing required option '%s'", funcName, allnames{n});
+      endif
+
+      ## if required < 0, option have been used more than once
+      if required.(allnames{n}) < 0
+        error("%s: option '%s' used multiple times", funcName, allnames{n});
+      endif
+
+    endif
+
+  endfor
+
+  ## check for mutually exclusive/required options
+  for n = 1:length(atleastone)
+    optsset = cellfun(@(name) allowed.(name) == 0, atleastone{n});
+    if sum(optsset) < 1
+      error("%s: at least one of options '%s' are required", funcName, strjoin(atleastone{n}, "', '"));
+    endif
+  endfor
+  for n = 1:length(exactlyone)
+    optsset = cellfun(@(name) allowed.(name) == 0, exactlyone{n});
+    if sum(optsset) != 1
+      error("%s: exactly one of options '%s' are required", funcName, strjoin(exactlyone{n}, "', '"));
+    endif
+  endfor
+  for n = 1:length(atmostone)
+    optsset = cellfun(@(name) allowed.(name) == 0, atmostone{n});
+    if sum(optsset) > 1
+      error("%s: at most one of options '%s' are required", funcName, strjoin(atmostone{n}, "', '"));
+    endif
+  endfor
+  for n = 1:length(noneorall)
+    optsset = cellfun(@(name) allowed.(name) == 0, noneorall{n});
+    if any(optsset) && !all(optsset)
+      error("%s: either none or all of options '%s' are required", funcName, strjoin(noneorall{n}, "', '"));
+    endif
+  endfor
+
+  ## convert all option variables to the required type
+  paroptnames = fieldnames(paropts);
+  for n = 1:length(paroptnames)
+    convfuncptr = convfunc.(paroptnames{n});
+    if !isempty(convfuncptr)
+      try
+        paropts.(paroptnames{n}) = feval(convfuncptr, paropts.(paroptnames{n}));
+      catch
+        error("%s: could not convert evaluate %s(value of option '%s')", funcName, func2str(convfuncptr), paroptnames{n});
+      end_try_catch
+    endif
+  endfor
+
+  ## return options struct, and/or assign to option variables in caller namespace
+  if nargout == 1
+    varargout = {paropts};
+  elseif nargout == 2
+    varargout = {[], paropts};
+  endif
+  if nargout != 1
+    for n = 1:length(paroptnames)
+      assignin("caller", paroptnames{n}, paropts.(paroptnames{n}));
+    endfor
+  endif
+
+endfunction
+
+## compile option specifications
+function spec = compile_optspecs(optspecs)
+
   ## store information about options
   optchars = struct;
   allowed = struct;
   required = struct;
   reqnames = {};
+  defnames = {};
+  defindex = [];
   typefunc = struct;
+  typechk = struct;
+  acceptschar = struct;
   convfunc = struct;
   noargvalue = struct;
   atleastone = {};
@@ -110,9 +366,15 @@ function varargout = parseOptions(opts, varargin)
   atmostone = {};
   noneorall = {};
 
+  ## codes of type keywords which can be checked by check_type()
+  typecodes = struct("bool", 1, "logical", 1, "cell", 2, "function", 3,
+                     "complex", 4, "real", 5, "integer", 6, "evenint", 7, "oddint", 8,
+                     "nonzero", 9, "positive", 10, "negative", 11, "strictpos", 12, "strictneg", 13,
+                     "unit", 14, "strictunit", 15, "char", 16, "numeric", 17, "scalar", 18, "struct", 19);
+
   ## parse option specifications
-  for n = 1:length(varargin)
-    optspec = varargin{n};
+  for n = 1:length(optspecs)
+    optspec = optspecs{n};
 
     ## allow [] as part of option specifications, e.g. as a spacer
     if !iscell(optspec) && !ischar(optspec) && isempty(optspec)
@@ -144,6 +406,9 @@ function varargout = parseOptions(opts, varargin)
 
     ## store option specifications
     typefuncstr = "( ";
+    typecmdstr = "";
+    typechkcodes = [];
+    typechkfuncs = {};
     convfuncptr = [];
     noargval = [];
     opttypes = strtrim(strsplit(optspec{2}, ",", true));
@@ -179,36 +444,42 @@ function varargout = parseOptions(opts, varargin)
       if !isempty(typefunccmd)
         switch typefunccmd
           case "a"
-            typefuncstr = cstrcat(typefuncstr, "isa(x,\"", typefuncarg, "\")");
+            typecmd = cstrcat("isa(x,\"", typefuncarg, "\")");
           case "acell"
-            typefuncstr = cstrcat(typefuncstr, "isa(x,\"", typefuncarg, "\") || (iscell(x) && cellfun(@isa,x,{\"", typefuncarg, "\"}))");
+            typecmd = cstrcat("isa(x,\"", typefuncarg, "\") || (iscell(x) && cellfun(@isa,x,{\"", typefuncarg, "\"}))");
           case "size"
             x = str2double(typefuncarg);
             if !isvector(x) || any(mod(x,1) != 0) || any(x < 0)
               error("%s: argument to type specification command '%s' is not an integer vector", funcName, typefunccmd);
             endif
-            typefuncstr = cstrcat(typefuncstr, "all(size(x)==[", typefuncarg, "])");
+            typecmd = cstrcat("all(size(x)==[", typefuncarg, "])");
           case "numel"
             x = str2double(typefuncarg);
             if !isscalar(x) || mod(x,1) != 0 || x < 0
               error("%s: argument to type specification command '%s' is not an integer scalar", funcName, typefunccmd);
             endif
-            typefuncstr = cstrcat(typefuncstr, "numel(x)==[", typefuncarg, "]");
+            typecmd = cstrcat("numel(x)==[", typefuncarg, "]");
           case "rows"
             x = str2double(typefuncarg);
             if !isscalar(x) || mod(x,1) != 0 || x < 0
               error("%s: argument to type specification command '%s' is not an integer scalar", funcName, typefunccmd);
             endif
-            typefuncstr = cstrcat(typefuncstr, "rows(x)==[", typefuncarg, "]");
+            typecmd = cstrcat("rows(x)==[", typefuncarg, "]");
           case "cols"
             x = str2double(typefuncarg);
             if !isscalar(x) || mod(x,1) != 0 || x < 0
               error("%s: argument to type specification command '%s' is not an integer scalar", funcName, typefunccmd);
             endif
-            typefuncstr = cstrcat(typefuncstr, "columns(x)==[", typefuncarg, "]");
+            typecmd = cstrcat("columns(x)==[", typefuncarg, "]");
           otherwise
             error("%s: unknown type specification command '%s'", funcName, typefunccmd);
         endswitch
+        typefuncstr = cstrcat(typefuncstr, typecmd);
+        if isempty(typecmdstr)
+          typecmdstr = cstrcat("( ", typecmd, " )");
+        else
+          typecmdstr = cstrcat(typecmdstr, " && ( ", typecmd, " )");
+        endif
         continue
       endif
 
@@ -254,11 +525,14 @@ function varargout = parseOptions(opts, varargin)
         otherwise
           typefuncfunc = cstrcat("is", typefuncarg);
           try
-            str2func(typefuncfunc);
+            typefuncptr = str2func(typefuncfunc);
             typefuncstr = cstrcat(typefuncstr, typefuncfunc, "(x)");
           catch
             error("%s: unknown type specification function '%s'", funcName, typefuncfunc);
           end_try_catch
+          if !isfield(typecodes, typefuncarg)
+            typechkfuncs{end+1} = typefuncptr;
+          endif
           if isempty(convfuncptr)
             try
               convfuncptr = str2func(typefuncarg);
@@ -268,6 +542,9 @@ function varargout = parseOptions(opts, varargin)
             end_try_catch
           endif
       endswitch
+      if isfield(typecodes, typefuncarg)
+        typechkcodes(end+1) = typecodes.(typefuncarg);
+      endif
 
     endfor
 
@@ -282,15 +559,27 @@ function varargout = parseOptions(opts, varargin)
       error("%s: invalid type specification %s for option '%s'", funcName, optspec{2}, optname);
     end_try_catch
 
+    ## split type specification into type keywords which are checked by check_type(),
+    ## type functions, and any remaining type specification commands
+    typechk.(optname) = struct("codes", typechkcodes, "funcs", {typechkfuncs}, "cmds", []);
+    if !isempty(typecmdstr)
+      typechk.(optname).cmds = inline(typecmdstr, "x");
+    endif
+
+    ## determine whether option accepts a 'char' value; if this cannot be
+    ## determined here, it is determined when the option is parsed
+    try
+      acceptschar.(optname) = logical(feval(typefunc.(optname), "string"));
+    catch
+      acceptschar.(optname) = [];
+    end_try_catch
+
     ## if this is an optional option
     if length(optspec) == 3
 
-      ## assign default value, if it's the right type
-      optvalue = optspec{3};
-      if !(isempty(optvalue) || feval(typefunc.(optname), optvalue))
-        error("%s: default value of '%s' must be empty or satisfy %s", funcName, optname, formula(typefunc.(optname)));
-      endif
-      paropts.(optname) = optvalue;
+      ## store option name and index of its default value
+      defnames{end+1} = optname;
+      defindex(end+1) = n;
 
     else
 
@@ -302,177 +591,117 @@ function varargout = parseOptions(opts, varargin)
 
   endfor
 
-  ## list of allowed options
-  allowed_names = fieldnames(allowed);
-
-  ## split function arguments into regular options and keyword-value pairs
-  [regopts, kvopts] = parseparams(opts);
-
-  ## check if there's more regular options than required options
-  if length(regopts) > length(reqnames)
-    error("%s: too many regular arguments, maximum is %i", funcName, length(reqnames))
-  endif
-
-  ## assign regular options in order given by 'reqnames'
-  for n = 1:length(regopts)
+  ## return compiled option specifications
+  spec = struct;
+  spec.optchars = optchars;
+  spec.allowed = allowed;
+  spec.required = required;
+  spec.reqnames = reqnames;
+  spec.defnames = defnames;
+  spec.defindex = defindex;
+  spec.typefunc = typefunc;
+  spec.typechk = typechk;
+  spec.acceptschar = acceptschar;
+  spec.convfunc = convfunc;
+  spec.noargvalue = noargvalue;
+  spec.atleastone = atleastone;
+  spec.exactlyone = exactlyone;
+  spec.atmostone = atmostone;
+  spec.noneorall = noneorall;
 
-    ## assign option value, if it's the right type
-    if !feval(typefunc.(reqnames{n}), regopts{n})
-      error("%s: value of '%s' must satisfy %s", funcName, reqnames{n}, formula(typefunc.(reqnames{n})));
-    endif
-    paropts.(reqnames{n}) = regopts{n};
-
-    ## mark that this option has been used
-    --allowed.(reqnames{n});
-    --required.(reqnames{n});
+endfunction
 
-  endfor
+## check that a value satisfies a compiled type specification
+function ok = check_type(chk, typefunc, x)
 
-  ## check that there's an even number of items in the keyword-value list
-  if mod(length(kvopts), 2) != 0
-    error("%s: expected 'key',value pairs following regular options in args", funcName);
+  ## check type keywords, using parseOptionsTypeCheck() if available
+  persistent have_typecheck = (exist("parseOptionsTypeCheck") == 3);
+  if have_typecheck
+    ok = parseOptionsTypeCheck(chk.codes, x);
+  else
+    ok = check_type_codes(chk.codes, x);
   endif
 
-  ## assign keyword-value options
-  for n = 1:2:length(kvopts)
-    optkey = kvopts{n};
-    optval = kvopts{n+1};
-
-    ## check that this option is an allowed option
-    if length(optkey) == 1 && isfield(optchars, optkey)
-      optkey = optchars.(optkey);
-    else
-      ii = find(cellfun(@(a_n) strcmp(optkey, a_n), allowed_names));
-      if length(ii) != 1
-        ii = find(cellfun(@(a_n) strncmp(optkey, a_n, min(length(a_n), max(length(optkey), 2))), allowed_names));
-        if length(ii) < 1
-          error("%s: unknown option '%s'", funcName, optkey);
-        endif
-        if length(ii) > 1
-          error("%s: ambiguous option '%s' (matches '%s')", funcName, optkey, strjoin(allowed_names(ii), "' or '"));
-        endif
-      endif
-      optkey = allowed_names{ii};
-    endif
-
-    ## if option does not accept a 'char' value, but option value is a 'char',
-    ## try evaluating it (this is used when parsing arguments from the command line)
-    if !feval(typefunc.(optkey), "string") && ischar(optval) && !isobject(optval)
-      try
-        ## convert string expression to number, but evaluate it inside a
-        ## temporary function so that it cannot access local variables
-        eval(sprintf("function x = __tmp__; x = [%s]; endfunction; optval = __tmp__(); clear __tmp__;", optval));
-      catch
-        error("%s: could not create a value from '--%s=%s'", funcName, optkey, optval);
-      end_try_catch
-    endif
-
-    ## special value to indicate argument with no value
-    if isequal(optval, {{}})
-      if isempty(noargvalue.(optkey))
-        error("%s: option '%s' requires an argument", funcName, optkey);
-      endif
-      paropts.(optkey) = noargvalue.(optkey);
-    else
-
-      ## assign option value, if it's the right type
-      if !feval(typefunc.(optkey), optval)
-
-        ## if option value is empty, use default (i.e. do nothing), otherwise raise error
-        if iscell(optval) || ischar(optval) || !isempty(optval)
-          error("%s: value of '%s' must satisfy %s", funcName, optkey, formula(typefunc.(optkey)));
-        endif
-
-      else
-        paropts.(optkey) = optval;
-      endif
+  ## if value could not be checked, evaluate full type specification
+  if isempty(ok)
+    ok = feval(typefunc, x);
+    return
+  endif
 
+  ## check type functions and type specification commands
+  for i = 1:length(chk.funcs)
+    if !ok
+      return
     endif
-
-    ## mark that this option has been used
-    --allowed.(optkey);
-    if isfield(required, optkey)
-      --required.(optkey);
-    endif
-
+    ok = chk.funcs{i}(x);
   endfor
+  if ok && !isempty(chk.cmds)
+    ok = feval(chk.cmds, x);
+  endif
 
-  ## check that options have been used correctly
-  allnames = fieldnames(allowed);
-  for n = 1:length(allnames)
-
-    ## if allowed < 0, option have been used more than once
-    if allowed.(allnames{n}) < 0
-      error("%s: option '%s' used multiple times", funcName, allnames{n});
-    endif
-
-    if isfield(required, allnames{n})
-
-      ## if required > 0, required option have been used at all
-      if required.(allnames{n}) > 0
-        error("%s: missing required option '%s'", funcName, allnames{n});
-      endif
-
-      ## if required < 0, option have been used more than once
-      if required.(allnames{n}) < 0
-        error("%s: option '%s' used multiple times", funcName, allnames{n});
-      endif
+endfunction
 
+## check type keywords; this must give the same results as parseOptionsTypeCheck()
+function ok = check_type_codes(codes, x)
+  ok = true;
+  for code = codes
+    if code >= 6 && code <= 15 && isnumeric(x) && iscomplex(x)
+      ok = [];
+      return
     endif
-
-  endfor
-
-  ## check for mutually exclusive/required options
-  for n = 1:length(atleastone)
-    optsset = cellfun(@(name) allowed.(name) == 0, atleastone{n});
-    if sum(optsset) < 1
-      error("%s: at least one of options '%s' are required", funcName, strjoin(atleastone{n}, "', '"));
-    endif
-  endfor
-  for n = 1:length(exactlyone)
-    optsset = cellfun(@(name) allowed.(name) == 0, exactlyone{n});
-    if sum(optsset) != 1
-      error("%s: exactly one of options '%s' are required", funcName, strjoin(exactlyone{n}, "', '"));
-    endif
-  endfor
-  for n = 1:length(atmostone)
-    optsset = cellfun(@(name) allowed.(name) == 0, atmostone{n});
-    if sum(optsset) > 1
-      error("%s: at most one of options '%s' are required", funcName, strjoin(atmostone{n}, "', '"));
-    endif
-  endfor
-  for n = 1:length(noneorall)
-    optsset = cellfun(@(name) allowed.(name) == 0, noneorall{n});
-    if any(optsset) && !all(optsset)
-      error("%s: either none or all of options '%s' are required", funcName, strjoin(noneorall{n}, "', '"));
-    endif
-  endfor
-
-  ## convert all option variables to the required type
-  paroptnames = fieldnames(paropts);
-  for n = 1:length(paroptnames)
-    convfuncptr = convfunc.(paroptnames{n});
-    if !isempty(convfuncptr)
-      try
-        paropts.(paroptnames{n}) = feval(convfuncptr, paropts.(paroptnames{n}));
-      catch
-        error("%s: could not convert evaluate %s(value of option '%s')", funcName, func2str(convfuncptr), paroptnames{n});
-      end_try_catch
+    switch code
+      case 1
+        ok = islogical(x) || ( isnumeric(x) && all((x(:)==0)|(x(:)==1)) );
+      case 2
+        ok = iscell(x);
+      case 3
+        ok = is_function_handle(x);
+      case 4
+        ok = isnumeric(x);
+      case 5
+        ok = isnumeric(x) && isreal(x);
+      case 6
+        ok = isnumeric(x) && all(mod(x(:),1)==0);
+      case 7
+        ok = isnumeric(x) && all(mod(x(:),2)==0);
+      case 8
+        ok = isnumeric(x) && all(mod(x(:),2)==1);
+      case 9
+        ok = isnumeric(x) && all(x(:)!=0);
+      case 10
+        ok = isnumeric(x) && all(x(:)>=0);
+      case 11
+        ok = isnumeric(x) && all(x(:)<=0);
+      case 12
+        ok = isnumeric(x) && all(x(:)>0);
+      case 13
+        ok = isnumeric(x) && all(x(:)<0);
+      case 14
+        ok = isnumeric(x) && all(0<=x(:)) && all(x(:)<=1);
+      case 15
+        ok = isnumeric(x) && all(0<x(:)) && all(x(:)<1);
+      case 16
+        ok = ischar(x);
+      case 17
+        ok = isnumeric(x);
+      case 18
+        ok = isscalar(x);
+      case 19
+        ok = isstruct(x);
+    endswitch
+    if !ok
+      return
     endif
   endfor
+endfunction
 
-  ## return options struct, and/or assign to option variables in caller namespace
-  if nargout == 1
-    varargout = {paropts};
-  elseif nargout == 2
-    varargout = {[], paropts};
-  endif
-  if nargout != 1
-    for n = 1:length(paroptnames)
-      assignin("caller", paroptnames{n}, paropts.(paroptnames{n}));
-    endfor
+## check whether an option accepts a 'char' value
+function ok = accepts_char(acceptschar, typefunc)
+  if isempty(acceptschar)
+    ok = feval(typefunc, "string");
+  else
+    ok = acceptschar;
   endif
-
 endfunction
 
 %!assert(__test_parseOptions__("real_strictpos_scalar", 2.34, "integer_vector", [9,-1], "string", "Over there", "cell", {1;3}), 'struct("cell",{{1;3}},"twobytwo",{[1 0;0 1]},"real_strictpos_scalar",{2.34},"integer_vector",{[9 -1]},"string",{"Over there"})')
@@ -486,3 +715,36 @@ endfunction
 %!  [status, output] = system("octapps_run __test_parseOptions__ --real-strictpos-scalar 1.23 --integer-vector='[3,9,5]' --string 'Hi there' --cell '{1,{2,3}}'");
 %!  assert(status == 0);
 %!  assert(strtrim(output), 'struct("cell",{{1,{2,3}}},"twobytwo",{[1 0;0 1]},"real_strictpos_scalar",{1.23},"integer_vector",{[3 9 5]},"string",{"Hi there"})')
+
+%!test
+%!  parseOptions("cache", false);
+%!  unwind_protect
+%!    assert(__test_parseOptions__("real_strictpos_scalar", 2.34, "integer_vector", [9,-1], "string", "Over there", "cell", {1;3}), 'struct("cell",{{1;3}},"twobytwo",{[1 0;0 1]},"real_strictpos_scalar",{2.34},"integer_vector",{[9 -1]},"string",{"Over there"})')
+%!  unwind_protect_cleanup
+%!    parseOptions("cache", true);
+%!  end_unwind_protect
+
+%!test
+%!  opts = parseOptions({}, {"x", "real,strictpos", 1});
+%!  assert(opts.x, 1);
+%!  opts = parseOptions({"x", 3}, {"x", "real,strictpos", 2});
+%!  assert(opts.x, 3);
+%!  fail('parseOptions({}, {"x", "real,strictpos", -1})', "default value of 'x' must be empty");
+%!  fail('parseOptions({"x", 1i}, {"x", "integer", 2})');
+%!  opts = parseOptions({"x", int8([2 4])}, {"x", "evenint,vector", 0});
+%!  assert(opts.x, int8([2 4]));
+
+%!demo
+%!  ## per-call overhead of parseOptions(), without and with cached option specifications
+%!  args = {"real_strictpos_scalar", 2.34, "integer_vector", [9,-1], "string", "Over there", "cell", {1;3}};
+%!  N = 200;
+%!  for use_cache = [false, true]
+%!    parseOptions("cache", use_cache);
+%!    __test_parseOptions__(args{:});
+%!    t0 = tic;
+%!    for i = 1:N
+%!      __test_parseOptions__(args{:});
+%!    endfor
+%!    printf("cache = %i: %.1f us per call\n", use_cache, 1e6 * toc(t0) / N);
+%!  endfor
+%!  parseOptions("cache", true);
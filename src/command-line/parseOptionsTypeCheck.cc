@@ -0,0 +1,227 @@
+//
+// Copyright (C) 2026 Karl Wette
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with with program; see the file COPYING. If not, write to the
+// Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+// MA  02111-1307  USA
+//
+
+#include <cmath>
+
+#include <octave/oct.h>
+#if OCTAVE_VERSION_HEX >= 0x040200
+#include <octave/interpreter.h>
+#else
+#include <octave/toplev.h>
+#endif
+
+// Type keyword codes; must match the codes used by parseOptions()
+enum type_code {
+  TC_BOOL = 1,
+  TC_CELL,
+  TC_FUNCTION,
+  TC_COMPLEX,
+  TC_REAL,
+  TC_INTEGER,
+  TC_EVENINT,
+  TC_ODDINT,
+  TC_NONZERO,
+  TC_POSITIVE,
+  TC_NEGATIVE,
+  TC_STRICTPOS,
+  TC_STRICTNEG,
+  TC_UNIT,
+  TC_STRICTUNIT,
+  TC_CHAR,
+  TC_NUMERIC,
+  TC_SCALAR,
+  TC_STRUCT,
+  TC_MAX
+};
+
+static const char *const parseOptionsTypeCheck_usage = "-*- texinfo -*- \n\
+@deftypefn {Loadable Function} {@var{ok} =} parseOptionsTypeCheck ( @var{codes}, @var{x} )\n\
+\n\
+Check whether the value @var{x} satisfies all of the type keywords whose codes \
+are given in the vector @var{codes}; used by @command{parseOptions()} to check \
+the most common type keywords without evaluating Octave expressions.\n\
+\n\
+Returns @var{ok} as @code{true} or @code{false}, or @code{[]} if @var{x} cannot \
+be checked here (e.g. for complex @var{x}), in which case @command{parseOptions()} \
+evaluates the full type specification.\n\
+\n\
+@end deftypefn";
+
+// Check that all elements of a real array satisfy a predicate
+template<class P> static bool all_of(const NDArray& a, P p) {
+  const double *x = a.data();
+  for (octave_idx_type i = 0; i < a.numel(); ++i) {
+    if (!p(x[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool is_bool01(double x) { return x == 0 || x == 1; }
+static bool is_int(double x) { return std::isfinite(x) && x == std::floor(x); }
+static bool is_evenint(double x) { return std::isfinite(x) && std::fmod(x, 2.0) == 0; }
+static bool is_oddint(double x) { if (!std::isfinite(x)) return false; double m = std::fmod(x, 2.0); if (m < 0) m += 2.0; return m == 1; }
+static bool is_nonzero(double x) { return x != 0; }
+static bool is_positive(double x) { return x >= 0; }
+static bool is_negative(double x) { return x <= 0; }
+static bool is_strictpos(double x) { return x > 0; }
+static bool is_strictneg(double x) { return x < 0; }
+static bool is_unit(double x) { return 0 <= x && x <= 1; }
+static bool is_strictunit(double x) { return 0 < x && x < 1; }
+
+DEFUN_DLD( parseOptionsTypeCheck, args, nargout, parseOptionsTypeCheck_usage ) {
+
+  // Prevent octave from crashing ...
+#if OCTAVE_VERSION_HEX < 0x040400
+  octave_exit = ::_Exit;
+#endif
+
+  // Check input and output
+  if (args.length() != 2 || nargout > 1) {
+    print_usage();
+    return octave_value();
+  }
+  const NDArray codes = args(0).array_value();
+  const octave_value& x = args(1);
+
+  // Determine class of value
+  const bool numeric = x.is_numeric_type();
+  const bool complex = numeric && x.is_complex_type();
+
+  // Elements of real numeric values, converted to double only if needed
+  NDArray xa;
+  bool have_xa = false;
+
+  for (octave_idx_type i = 0; i < codes.numel(); ++i) {
+    const int code = (int) codes(i);
+
+    // Checks on class or size of value
+    bool ok = true;
+    switch (code) {
+    case TC_CELL:
+      ok = x.is_cell();
+      break;
+    case TC_FUNCTION:
+      ok = x.is_function_handle();
+      break;
+    case TC_COMPLEX:
+    case TC_NUMERIC:
+      ok = numeric;
+      break;
+    case TC_REAL:
+      ok = numeric && !complex;
+      break;
+    case TC_CHAR:
+      ok = x.is_string();
+      break;
+    case TC_SCALAR:
+      ok = (x.numel() == 1);
+      break;
+    case TC_STRUCT:
+      ok = x.is_map();
+      break;
+    case TC_BOOL:
+      if (x.is_bool_type()) {
+        break;
+      }
+      // fall through
+    default:
+
+      // Checks on elements of numeric value
+      if (code < TC_BOOL || code >= TC_MAX) {
+        error("invalid type keyword code %i", code);
+        return octave_value();
+      }
+      if (!numeric) {
+        ok = false;
+        break;
+      }
+      if (complex) {
+        return octave_value(Matrix());
+      }
+      if (!have_xa) {
+        xa = x.array_value();
+        have_xa = true;
+      }
+      switch (code) {
+      case TC_BOOL:
+        ok = all_of(xa, is_bool01);
+        break;
+      case TC_INTEGER:
+        ok = all_of(xa, is_int);
+        break;
+      case TC_EVENINT:
+        ok = all_of(xa, is_evenint);
+        break;
+      case TC_ODDINT:
+        ok = all_of(xa, is_oddint);
+        break;
+      case TC_NONZERO:
+        ok = all_of(xa, is_nonzero);
+        break;
+      case TC_POSITIVE:
+        ok = all_of(xa, is_positive);
+        break;
+      case TC_NEGATIVE:
+        ok = all_of(xa, is_negative);
+        break;
+      case TC_STRICTPOS:
+        ok = all_of(xa, is_strictpos);
+        break;
+      case TC_STRICTNEG:
+        ok = all_of(xa, is_strictneg);
+        break;
+      case TC_UNIT:
+        ok = all_of(xa, is_unit);
+        break;
+      case TC_STRICTUNIT:
+        ok = all_of(xa, is_strictunit);
+        break;
+      }
+
+    }
+    if (!ok) {
+      return octave_value(false);
+    }
+
+  }
+
+  return octave_value(true);
+
+}
+
+/*
+
+%!assert(parseOptionsTypeCheck([5, 12, 18], 2.34))
+%!assert(!parseOptionsTypeCheck([5, 12, 18], [1, 2]))
+%!assert(parseOptionsTypeCheck([6], [9, -1]))
+%!assert(!parseOptionsTypeCheck([6], [9, NaN]))
+%!assert(parseOptionsTypeCheck([1], true))
+%!assert(parseOptionsTypeCheck([1], [0, 1]))
+%!assert(!parseOptionsTypeCheck([1], 2))
+%!assert(parseOptionsTypeCheck([8], -3))
+%!assert(!parseOptionsTypeCheck([10], "x"))
+%!assert(parseOptionsTypeCheck([16], "x"))
+%!assert(parseOptionsTypeCheck([2], {}))
+%!assert(parseOptionsTypeCheck([3], @sin))
+%!assert(parseOptionsTypeCheck([19], struct))
+%!assert(isempty(parseOptionsTypeCheck([12], 1i)))
+
+*/
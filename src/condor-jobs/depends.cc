@@ -31,6 +31,8 @@
 #include <octave/pt-all.h>
 #include <octave/Cell.h>
 
+#include "octapps_prof.hpp"
+
 #if OCTAVE_VERSION_HEX <= 0x030204
 #define octave_map Octave_map
 #endif
@@ -501,6 +503,8 @@ DEFUN_DLD( depends, args, nargout, depends_usage ) {
     return octave_value();
   }
 
+  octapps_prof::scope prof("depends");
+
   // If given, get cell list of excluded prefixes
   Cell exclude;
   octave_idx_type i = 0;
@@ -532,9 +536,12 @@ DEFUN_DLD( depends, args, nargout, depends_usage ) {
     }
 
     // Walk over function
+    octapps_prof::scope prof_walk(prof, "depends:walk");
     dep_walk.walk_function(args(i).string_value());
 
   }
+  prof.count("depends:functions", dep_walk.functions.nfields());
+  prof.count("depends:extra_files", dep_walk.extra_files.size());
 
   // Create cell array of extra files
   Cell extra_files(1, dep_walk.extra_files.size());
@@ -78,6 +78,12 @@
 ## Hierarchical Data Format version 5 format; file extension will be .hdf5
 ## @item Mat
 ## Matlab (version 6) binary format; file extension will be .mat
+## @item OctCol(Z)
+## OctApps column-block (compressed) format, written by @command{octcolwrite()};
+## file extension will be .col. Results can only contain numeric, logical, or
+## character arrays, cell arrays, structs, or old-style class objects, but
+## selected results can be read back without decoding the rest of the file;
+## see @command{octcolread()} and @command{mergeCondorResults()}
 ## @end table
 ## Default is "OctBinZ"
 ##
@@ -152,10 +158,13 @@ function job_file = makeCondorJob(varargin)
     case "OctBinZ";  save_args = {"-binary", "-zip"}; save_ext = "bin.gz";
     case "HDF5";     save_args = {"-hdf5"};           save_ext = "hdf5";
     case "Mat";      save_args = {"-mat-binary"};     save_ext = "mat";
+    case "OctCol";   save_args = {"none"};            save_ext = "col";
+    case "OctColZ";  save_args = {"auto"};            save_ext = "col";
     otherwise
       error("%s: unknown output format '%s'", funcName, output_format);
   endswitch
   save_args = strjoin(save_args, "\", \"");
+  save_octcol = strncmp(output_format, "OctCol", 6);
 
   ## check that log directory exists
   if exist(log_dir, "dir")
@@ -232,8 +241,12 @@ function job_file = makeCondorJob(varargin)
   octprefixes = cellfun(@octapps_config_info, {"fcnfiledir", "octfiledir"}, "UniformOutput", false);
   libprefixes = {"/lib", "/usr/lib"};
 
-  ## get dependencies of job function
-  [func_files, func_extra_files] = depends(octprefixes, func_name);
+  ## get dependencies of job function, and of the function which saves its output
+  if save_octcol
+    [func_files, func_extra_files] = depends(octprefixes, func_name, "octcolwrite");
+  else
+    [func_files, func_extra_files] = depends(octprefixes, func_name);
+  endif
   func_files = struct2cell(func_files);
 
   ## find if any job function dependencies are .oct modules
@@ -340,7 +353,11 @@ function job_file = makeCondorJob(varargin)
                         "condor_ID", "condor_node", "arguments", ...
                         "results", "wall_time", "cpu_time", ...
                       }, "\", \"");
-  bootstr = strcat(bootstr, sprintf("save(\"%s\", \"stdres.%s\", \"%s\");\n", save_args, save_ext, save_vars));
+  if save_octcol
+    bootstr = strcat(bootstr, sprintf("octcolwrite(\"stdres.%s\", struct(\"condor_ID\", condor_ID, \"condor_node\", condor_node, \"arguments\", {arguments}, \"results\", {results}, \"wall_time\", wall_time, \"cpu_time\", cpu_time), \"%s\");\n", save_ext, save_args));
+  else
+    bootstr = strcat(bootstr, sprintf("save(\"%s\", \"stdres.%s\", \"%s\");\n", save_args, save_ext, save_vars));
+  endif
   bootstr = strcat(bootstr, "EOF\n");
 
   ## build Condor arguments string containing Octave function arguments
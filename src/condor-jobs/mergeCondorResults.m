@@ -45,7 +45,15 @@
 ## @end example
 ## where 'res' are to be merged into 'merged_res', and
 ## 'args' are the arguments passed to the job.
-## One function per element of job 'results' must be given.
+## One function per element of job 'results' must be given,
+## or if 'results_index' is given, one function per selected
+## element of job 'results'.
+##
+## @item results_index
+## If given, indices of the elements of job 'results' to merge;
+## other elements are ignored. If job results were saved in the
+## OctCol format (see @command{makeCondorJob()}), ignored elements
+## are never read from disk.
 ##
 ## @item norm_function
 ## If given, function(s) used to normalise merged results
@@ -54,7 +62,9 @@
 ##   merged_res = norm_function(merged_res, n)
 ## @end example
 ## where 'n' is the number of merged Condor jobs.
-## One function per element of job 'results' must be given.
+## One function per element of job 'results' must be given,
+## or if 'results_index' is given, one function per selected
+## element of job 'results'.
 ##
 ## @item save_period
 ## How often merged results should be saved (default: 90 sec).
@@ -80,6 +90,7 @@ function mergeCondorResults(varargin)
                {"merged_suffix", "char", "merged"},
                {"args_filter", "function,scalar", []},
                {"merge_function", "function,vector"},
+               {"results_index", "integer,strictpos,vector", []},
                {"norm_function", "function,vector", []},
                {"save_period", "real,strictpos,scalar", 90},
                {"extra_data", "struct", []},
@@ -157,9 +168,23 @@ function mergeCondorResults(varargin)
       endif
       if size(node_result_file, 1) == 1
         try
-          node_results = load(node_result_file{1});
+          [_, _, node_result_ext] = fileparts(node_result_file{1});
+          if strcmp(node_result_ext, ".col")
+            if isempty(results_index)
+              node_results = octcolread(node_result_file{1}, "arguments", "results", "cpu_time", "wall_time");
+            else
+              node_results = octcolread(node_result_file{1}, "arguments", "cpu_time", "wall_time",
+                                        arrayfun(@(i) sprintf("results{%i}", i), results_index, "UniformOutput", false));
+            endif
+          else
+            node_results = load(node_result_file{1});
+          endif
           break
-        catch
+        catch err
+          ## selector errors will not go away by retrying, so fail as for other result files
+          if strcmp(err.identifier, "octapps:octcolread:selector")
+            error("%s: job node '%s' results do not match 'results_index' or required fields: %s", funcName, job_nodes(n).name, err.message);
+          endif
         end_try_catch
       endif
       if tries < load_retries
@@ -183,6 +208,11 @@ function mergeCondorResults(varargin)
     assert(isfield(node_results, "results"), "%s: job node '%s' does not have field 'results'", funcName, job_nodes(n).name);
     assert(isfield(node_results, "cpu_time"), "%s: job node '%s' does not have field 'cpu_time'", funcName, job_nodes(n).name);
     assert(isfield(node_results, "wall_time"), "%s: job node '%s' does not have field 'wall_time'", funcName, job_nodes(n).name);
+    if !isempty(results_index)
+      assert(max(results_index) <= length(node_results.results),
+             "%s: 'results_index' exceeds number of job node '%s' results", funcName, job_nodes(n).name);
+      node_results.results = node_results.results(results_index);
+    endif
     assert(length(merge_function) == length(node_results.results),
            "%s: length of 'merge_function' does not match number of job node '%s' results", funcName, job_nodes(n).name);
     if !isempty(norm_function)
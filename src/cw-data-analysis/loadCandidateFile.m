@@ -21,9 +21,26 @@
 ## loads a 'candidate-file' from @command{lalapps_ComputeFStatistic_v2 --outputLoudest=cand.file}
 ## and returns a struct containing the data
 ##
+## To load many candidate files, use @command{loadCandidateFiles()}.
+##
 ## @end deftypefn
 
 function ret = loadCandidateFile ( fname )
+
+  ## use loadCandidateFiles() if available
+  if ( exist ( "loadCandidateFiles" ) == 3 )
+    cands = loadCandidateFiles ( { fname }, 1 );
+    for field = { "phi0", "dphi0", "psi", "dpsi", "h0", "dh0", "cosi", "dcosi", ...
+                  "Alpha", "Delta", "refTime", "Freq", "f1dot", "f2dot", "f3dot", ...
+                  "Ad", "Bd", "Cd", "Sinv_Tsft", "Fa", "Fb", "twoF" }
+      if ( !isfield ( cands, field{1} ) )
+        error ( "%s: '%s' is not assigned in candidate file '%s'", funcName, field{1}, fname );
+      endif
+      ret.(field{1}) = cands.(field{1});
+    endfor
+    return;
+  endif
+
   source ( fname );     ## uses only local variables!
 
   ## amplitude params with error-estimates
@@ -83,3 +100,7 @@ endfunction
 %!  runCode(args, "lalapps_ComputeFstatistic_v2");
 %!  cand_file = loadCandidateFile(args.outputLoudest);
 %!  assert(isstruct(cand_file));
+%!  if exist("loadCandidateFiles") == 3
+%!    cands = loadCandidateFiles({args.outputLoudest, args.outputLoudest});
+%!    assert(cands.twoF, [cand_file.twoF; cand_file.twoF]);
+%!  endif
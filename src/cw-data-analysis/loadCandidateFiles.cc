@@ -0,0 +1,378 @@
+//
+// Copyright (C) 2026 Karl Wette
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with with program; see the file COPYING. If not, write to the
+// Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+// MA  02111-1307  USA
+//
+
+#include <cctype>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <octave/oct.h>
+#if OCTAVE_VERSION_HEX >= 0x040200
+#include <octave/interpreter.h>
+#else
+#include <octave/toplev.h>
+#endif
+#include <octave/Cell.h>
+
+#if OCTAVE_VERSION_HEX <= 0x030204
+#define octave_map Octave_map
+#endif
+
+static const char *const loadCandidateFiles_usage = "-*- texinfo -*- \n\
+@deftypefn {Loadable Function} {@var{cands} =} loadCandidateFiles ( @var{fnames} )\n\
+@deftypefnx{Loadable Function} { [ @var{cands}, @var{errors} ] =} loadCandidateFiles ( @var{fnames} )\n\
+@deftypefnx{Loadable Function} { [ @dots{} ] =} loadCandidateFiles ( @var{fnames}, @var{num_threads} )\n\
+\n\
+Load many candidate files, as written by \
+@command{lalapps_ComputeFStatistic_v2 --outputLoudest=cand.file}, in parallel.\n\
+\n\
+@var{fnames} is a cell array of candidate file names. Each file must consist of \
+assignments @samp{@var{name} = @var{value};}, one per line, where @var{value} \
+is a real number, or a complex number written as e.g. @samp{1.2 -3.4i}; \
+comments starting with @samp{%} or @samp{#} are ignored.\n\
+\n\
+Returns a struct @var{cands}, with one field for each @var{name} found in any \
+file, whose value is a column vector with one element for each file in @var{fnames}. \
+Elements are @code{NaN} for files which could not be loaded, or which do not \
+assign @var{name}.\n\
+\n\
+If @var{errors} is requested, it is a cell array with one element for each \
+file in @var{fnames}: an empty string if the file was loaded, otherwise a \
+description of the error; otherwise an error is raised if any file could \
+not be loaded.\n\
+\n\
+Files are loaded using @var{num_threads} threads [default: number of processors].\n\
+\n\
+@end deftypefn";
+
+// Value assigned in a candidate file
+struct cand_value {
+  std::string name;
+  double re, im;
+};
+
+// Contents of a candidate file, or a description of the error loading it
+struct cand_file {
+  std::vector<cand_value> values;
+  std::string error;
+};
+
+// Skip whitespace, but not newlines
+static void skip_space(const char *&p, const char *end) {
+  while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) {
+    ++p;
+  }
+}
+
+// Parse a number; strtod() is not given the end of the buffer, so copy the number first
+static bool parse_number(const char *&p, const char *end, double& x) {
+  const char *q = p;
+  while (q < end && (isalnum(*q) || *q == '.' || *q == '+' || *q == '-')) {
+    ++q;
+  }
+  if (q == p || q - p > 64) {
+    return false;
+  }
+  char buf[65];
+  std::copy(p, q, buf);
+  buf[q - p] = '\0';
+  char *bufend = 0;
+  x = strtod(buf, &bufend);
+  if (bufend == buf) {
+    return false;
+  }
+  p += bufend - buf;
+  return true;
+}
+
+// Parse a candidate file
+static void parse_cand_file(const std::string& fname, cand_file& cf) {
+
+  // Read file
+  FILE *f = fopen(fname.c_str(), "rb");
+  if (f == 0) {
+    cf.error = std::string("could not open file: ") + strerror(errno);
+    return;
+  }
+  std::string buf;
+  char chunk[65536];
+  size_t n;
+  while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0) {
+    buf.append(chunk, n);
+  }
+  const bool read_error = ferror(f);
+  fclose(f);
+  if (read_error) {
+    cf.error = "could not read file";
+    return;
+  }
+
+  // Parse lines of the form 'name = value;'
+  const char *p = buf.data(), *end = buf.data() + buf.size();
+  size_t line = 1;
+  while (p < end) {
+    skip_space(p, end);
+
+    // Skip empty lines and comments
+    if (p < end && (*p == '%' || *p == '#')) {
+      while (p < end && *p != '\n') {
+        ++p;
+      }
+    }
+    if (p == end) {
+      break;
+    }
+    if (*p == '\n') {
+      ++p;
+      ++line;
+      continue;
+    }
+
+    // Parse name
+    char errbuf[64];
+    snprintf(errbuf, sizeof(errbuf), "line %zu: ", line);
+    if (!(isalpha(*p) || *p == '_')) {
+      cf.error = std::string(errbuf) + "expected a variable name";
+      return;
+    }
+    cand_value v;
+    while (p < end && (isalnum(*p) || *p == '_')) {
+      v.name += *p++;
+    }
+    skip_space(p, end);
+    if (p == end || *p != '=') {
+      cf.error = std::string(errbuf) + "expected '=' after '" + v.name + "'";
+      return;
+    }
+    ++p;
+    skip_space(p, end);
+
+    // Parse value: a real number 'x', an imaginary number 'yi', or a complex number 'x +yi'
+    v.re = v.im = 0;
+    bool ok = parse_number(p, end, v.re);
+    skip_space(p, end);
+    if (ok && p < end && (*p == 'i' || *p == 'j')) {
+      ++p;
+      std::swap(v.re, v.im);
+    } else if (ok && p < end && (*p == '+' || *p == '-')) {
+      const double sign = (*p++ == '-') ? -1 : 1;
+      skip_space(p, end);
+      ok = parse_number(p, end, v.im) && p < end && (*p == 'i' || *p == 'j');
+      if (ok) {
+        ++p;
+        v.im *= sign;
+      }
+    }
+    skip_space(p, end);
+    if (ok && p < end && *p == ';') {
+      ++p;
+      skip_space(p, end);
+    }
+    if (p < end && (*p == '%' || *p == '#')) {
+      while (p < end && *p != '\n') {
+        ++p;
+      }
+    }
+    if (!ok || (p < end && *p != '\n')) {
+      cf.error = std::string(errbuf) + "could not parse value of '" + v.name + "'";
+      return;
+    }
+
+    // Later assignments to the same name replace earlier ones
+    bool found = false;
+    for (size_t i = 0; i < cf.values.size(); ++i) {
+      if (cf.values[i].name == v.name) {
+        cf.values[i] = v;
+        found = true;
+        break;
+      }
+    }
+    if (!found) {
+      cf.values.push_back(v);
+    }
+
+  }
+
+}
+
+DEFUN_DLD( loadCandidateFiles, args, nargout, loadCandidateFiles_usage ) {
+
+  // Prevent octave from crashing ...
+#if OCTAVE_VERSION_HEX < 0x040400
+  octave_exit = ::_Exit;
+#endif
+
+  // Check input and output
+  if (args.length() < 1 || args.length() > 2 || nargout > 2) {
+    print_usage();
+    return octave_value();
+  }
+  if (!args(0).is_cell()) {
+    error("argument #1 is not a cell array of strings");
+    return octave_value();
+  }
+  const Cell fnames_cell = args(0).cell_value();
+  std::vector<std::string> fnames(fnames_cell.numel());
+  for (size_t i = 0; i < fnames.size(); ++i) {
+    if (!fnames_cell(i).is_string()) {
+      error("argument #1 is not a cell array of strings");
+      return octave_value();
+    }
+    fnames[i] = fnames_cell(i).string_value();
+  }
+  size_t num_threads = std::max(1u, std::thread::hardware_concurrency());
+  if (args.length() > 1) {
+    if (!args(1).is_real_scalar() || args(1).double_value() < 1) {
+      error("argument #2 is not a strictly positive integer");
+      return octave_value();
+    }
+    num_threads = (size_t) args(1).double_value();
+  }
+  num_threads = std::min(num_threads, fnames.size());
+
+  // Parse files; each thread parses every 'num_threads'th file, and only
+  // builds C++ data structures, since the Octave API is not thread-safe
+  std::vector<cand_file> cfs(fnames.size());
+  if (num_threads > 1) {
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < num_threads; ++t) {
+      threads.push_back(std::thread([&fnames, &cfs, t, num_threads]() {
+            for (size_t i = t; i < fnames.size(); i += num_threads) {
+              parse_cand_file(fnames[i], cfs[i]);
+            }
+          }));
+    }
+    for (size_t t = 0; t < num_threads; ++t) {
+      threads[t].join();
+    }
+  } else {
+    for (size_t i = 0; i < fnames.size(); ++i) {
+      parse_cand_file(fnames[i], cfs[i]);
+    }
+  }
+  octave_quit();
+
+  // Collect names in order of first appearance, and whether any of their values are complex
+  std::vector<std::string> names;
+  std::map<std::string, size_t> name_index;
+  std::vector<bool> name_complex;
+  for (size_t i = 0; i < cfs.size(); ++i) {
+    for (size_t j = 0; j < cfs[i].values.size(); ++j) {
+      const cand_value& v = cfs[i].values[j];
+      std::map<std::string, size_t>::const_iterator p = name_index.find(v.name);
+      size_t k;
+      if (p == name_index.end()) {
+        k = names.size();
+        name_index[v.name] = k;
+        names.push_back(v.name);
+        name_complex.push_back(false);
+      } else {
+        k = p->second;
+      }
+      if (v.im != 0) {
+        name_complex[k] = true;
+      }
+    }
+  }
+
+  // Build struct of column vectors
+  const octave_idx_type nfiles = fnames.size();
+  const double nan = lo_ieee_nan_value();
+  std::vector<ColumnVector> re(names.size(), ColumnVector(nfiles, nan));
+  std::vector<ComplexColumnVector> cx(names.size());
+  for (size_t k = 0; k < names.size(); ++k) {
+    if (name_complex[k]) {
+      cx[k] = ComplexColumnVector(nfiles, Complex(nan, 0));
+    }
+  }
+  for (size_t i = 0; i < cfs.size(); ++i) {
+    for (size_t j = 0; j < cfs[i].values.size(); ++j) {
+      const cand_value& v = cfs[i].values[j];
+      const size_t k = name_index[v.name];
+      if (name_complex[k]) {
+        cx[k](i) = Complex(v.re, v.im);
+      } else {
+        re[k](i) = v.re;
+      }
+    }
+  }
+  octave_map cands(dim_vector(1, 1));
+  for (size_t k = 0; k < names.size(); ++k) {
+    if (name_complex[k]) {
+      cands.setfield(names[k], Cell(octave_value(cx[k])));
+    } else {
+      cands.setfield(names[k], Cell(octave_value(re[k])));
+    }
+  }
+
+  // Return errors, or raise an error if any file could not be loaded
+  Cell errors(nfiles, 1);
+  size_t num_errors = 0, first_error = 0;
+  for (size_t i = 0; i < cfs.size(); ++i) {
+    errors(i) = octave_value(cfs[i].error);
+    if (!cfs[i].error.empty() && num_errors++ == 0) {
+      first_error = i;
+    }
+  }
+  if (nargout < 2 && num_errors > 0) {
+    error("could not load %zu candidate file(s), e.g. '%s': %s", num_errors, fnames[first_error].c_str(), cfs[first_error].error.c_str());
+    return octave_value();
+  }
+
+  octave_value_list retval;
+  retval(0) = octave_value(cands);
+  retval(1) = octave_value(errors);
+  return retval;
+
+}
+
+/*
+
+%!test
+%!  fnames = {tempname(tempdir), tempname(tempdir), tempname(tempdir)};
+%!  fid = fopen(fnames{1}, "w");
+%!  fprintf(fid, "%% candidate\nrefTime = 800000000.000000000;\nAlpha   =  1.2;\nFa       =  3.5  -1.5i;\ntwoF     =  12.5;\n");
+%!  fclose(fid);
+%!  fid = fopen(fnames{2}, "w");
+%!  fprintf(fid, "refTime = 800000000;\nAlpha = -4e-1;\nFa = 2i;\ntwoF = Inf;\nf1dot = -1e-9;\n");
+%!  fclose(fid);
+%!  fid = fopen(fnames{3}, "w");
+%!  fprintf(fid, "refTime = 800000000;\nAlpha = foo;\n");
+%!  fclose(fid);
+%!  [cands, errors] = loadCandidateFiles(fnames, 2);
+%!  assert(fieldnames(cands), {"refTime"; "Alpha"; "Fa"; "twoF"; "f1dot"});
+%!  assert(cands.refTime, [800000000; 800000000; 800000000]);
+%!  assert(cands.Alpha, [1.2; -0.4; NaN]);
+%!  assert(cands.Fa, [3.5 - 1.5i; 2i; NaN]);
+%!  assert(cands.twoF, [12.5; Inf; NaN]);
+%!  assert(cands.f1dot, [NaN; -1e-9; NaN]);
+%!  assert(isempty(errors{1}) && isempty(errors{2}));
+%!  assert(!isempty(strfind(errors{3}, "line 2")));
+%!  cands1 = loadCandidateFiles(fnames(1:2), 1);
+%!  assert(isequaln(cands1.Alpha, cands.Alpha(1:2)));
+%!  fail("loadCandidateFiles(fnames)", "could not load 1 candidate file");
+%!  cellfun(@unlink, fnames);
+
+*/
@@ -200,6 +200,7 @@ function [resampInfo, demodInfo] = predictFstatTimeAndMemory ( varargin )
 
   ## estimate sidebands as closely as possible to what's done in ComputeFstat, by using XLALCWSignalCoveringBand()
   FreqBandRS = zeros ( size(Tspan) );
+  numBinsLD = zeros ( size(Tspan) );
   extraBinsMethod = 8;  ## resampling 'extra bins' value
   fudge_up = 1 + 10 * eps;
   fudge_down = 1 - 10 * eps;
@@ -224,6 +225,7 @@ function [resampInfo, demodInfo] = predictFstatTimeAndMemory ( varargin )
     tmp = maxFreq / df;
     iMax = ceil  ( tmp * fudge_down );
     numBins = ( iMax - iMin + 1 );
+    numBinsLD(i) = numBins;
     FreqBandLoad = numBins * df;
 
     ## increase band for windowed-sinc
@@ -271,7 +273,7 @@ function [resampInfo, demodInfo] = predictFstatTimeAndMemory ( varargin )
   demodInfo.tauF_core   = Nsft * uvar.tau0_coreLD;
   demodInfo.tauF_buffer = Nsft ./ NFbin * uvar.tau0_bufferLD;
   ## ----- demod memory model:
-  demodInfo.MBDataPerDetSeg =  Nsft .* numBins * 8 / MB;
+  demodInfo.MBDataPerDetSeg =  Nsft .* numBinsLD * 8 / MB;
   ##
 
   return;
@@ -78,6 +78,9 @@
 
 function metrics = ComputeSuperskyMetrics(varargin)
 
+  ## profile this function
+  prof = octapps_prof_scope(funcName);
+
   ## load LAL libraries
   lal;
   lalpulsar;
@@ -116,14 +119,6 @@ function metrics = ComputeSuperskyMetrics(varargin)
 
   if cache_size > 0
 
-    ## set in-memory cache of supersky metrics structs
-    global supersky_metrics_cache;
-    if isempty(supersky_metrics_cache)
-      supersky_metrics_cache = struct;
-      supersky_metrics_cache.lookup = struct;
-      supersky_metrics_cache.usage = {};
-    endif
-
     ## get cache directory
     cache_dir = SuperskyMetricsCache();
 
@@ -147,15 +142,34 @@ function metrics = ComputeSuperskyMetrics(varargin)
     cache_file_short = fullfile(cache_file{end-1:end});
     cache_file = fullfile(mkpath(cache_dir, cache_file{1:end-1}), cache_file{end});
 
-    ## set cache key
-    cache_key = sprintf("key_%s", cache_file);
+    ## set cache key from the inputs which determine the supersky metrics;
+    ## metrics are kept in memory by octapps_cache() if available, otherwise
+    ## in a global struct, and on disk in the cache directory
+    have_cache = (exist("octapps_cache") == 3);
+    cache_key = octapps_md5sum(stringify({spindowns, ref_time, segment_list, detectors, detector_weights, detector_motion}));
+    found_in_memory = false;
+    if !have_cache
+      global supersky_metrics_cache;
+      if isempty(supersky_metrics_cache)
+        supersky_metrics_cache = struct;
+        supersky_metrics_cache.lookup = struct;
+        supersky_metrics_cache.usage = {};
+      endif
+      cache_key = strcat("key_", cache_key);
+    endif
 
     ## check for supersky metrics in cache
     DebugPrintf(4, "%s: checking for cached metric %s ...\n", funcName, cache_file_short);
-    if isfield(supersky_metrics_cache.lookup, cache_key)
+    if have_cache
+      octapps_cache("config", funcName, "max_entries", cache_size, "disk", false);
+      [found_in_memory, metrics] = octapps_cache("get", funcName, cache_key);
+    elseif isfield(supersky_metrics_cache.lookup, cache_key)
+      found_in_memory = true;
+      metrics = supersky_metrics_cache.lookup.(cache_key);
+    endif
+    if found_in_memory
 
-      ## retrieve from in-memory cache
-      metrics = getfield(supersky_metrics_cache.lookup, cache_key);
+      ## found in in-memory cache
       DebugPrintf(4, "%s:    found in memory\n", funcName);
 
     elseif exist(cache_file, "file")
@@ -228,13 +242,23 @@ function metrics = ComputeSuperskyMetrics(varargin)
 
     if cache_size > 0
 
-      ## save to cache file
+      ## save to cache file; the file is written under a temporary name and then
+      ## renamed, so that other processes sharing the cache directory never read
+      ## a partly-written file
+      cache_tmp_file = strcat(tempname(fileparts(cache_file), "tmp"), ".fits");
       try
-        fits_file = XLALFITSFileOpenWrite(cache_file);
+        fits_file = XLALFITSFileOpenWrite(cache_tmp_file);
         XLALFITSWriteSuperskyMetrics(fits_file, metrics);
         clear fits_file;
+        [err, msg] = rename(cache_tmp_file, cache_file);
+        if err != 0
+          error(msg);
+        endif
         DebugPrintf(4, "... saved to disk");
       catch
+        if exist(cache_tmp_file, "file")
+          unlink(cache_tmp_file);
+        endif
         DebugPrintf(4, "\n");
         error("%s: Could not save supersky metrics to disk", funcName);
       end_try_catch
@@ -247,15 +271,21 @@ function metrics = ComputeSuperskyMetrics(varargin)
   if cache_size > 0
 
     ## add to in-memory cache
-    if !isfield(supersky_metrics_cache.lookup, cache_key)
-      supersky_metrics_cache.lookup = setfield(supersky_metrics_cache.lookup, cache_key, metrics);
+    if have_cache
+      if !found_in_memory
+        octapps_cache("put", funcName, cache_key, metrics);
+      endif
+    else
+      if !found_in_memory
+        supersky_metrics_cache.lookup.(cache_key) = metrics;
+      endif
+      supersky_metrics_cache.usage = supersky_metrics_cache.usage(find(!strcmp(supersky_metrics_cache.usage, cache_key)));
+      supersky_metrics_cache.usage{end+1} = cache_key;
+      while length(supersky_metrics_cache.usage) > cache_size
+        supersky_metrics_cache.lookup = rmfield(supersky_metrics_cache.lookup, supersky_metrics_cache.usage{1});
+        supersky_metrics_cache.usage = supersky_metrics_cache.usage(2:end);
+      endwhile
     endif
-    supersky_metrics_cache.usage = supersky_metrics_cache.usage(find(!strcmp(supersky_metrics_cache.usage, cache_key)));
-    supersky_metrics_cache.usage{end+1} = cache_key;
-    while length(supersky_metrics_cache.usage) > cache_size
-      supersky_metrics_cache.lookup = rmfield(supersky_metrics_cache.lookup, supersky_metrics_cache.usage{1});
-      supersky_metrics_cache.usage = supersky_metrics_cache.usage(2:end);
-    endwhile
 
     ## make copy of metrics from cache to allow safe modification
     metrics = XLALCopySuperskyMetrics(metrics);
@@ -172,6 +172,47 @@ endfunction ## CostFunctionsDirected()
 %!  assert ( sol_v2.Nseg, 57.035, tol );
 %!  assert ( sol_v2.Tseg, 2.1643e+05, tol );
 
+## Check that concurrent solver trials, and memoised cost-function evaluations, give the same solution
+%!test
+%!  UnitsConstants;
+%!  refParams.Nseg = 32;
+%!  refParams.Tseg = 8.0 * 86400;
+%!  refParams.mCoh   = 0.12;
+%!  refParams.mInc   = 0.41;
+%!
+%!  costFuns = CostFunctionsDirected( ...
+%!                                  "fmin", 120, ...
+%!                                  "fmax", 1000, ...
+%!                                  "tau_min", 300 * YRSID_SI, ...
+%!                                  "detectors", "H1,L1",
+%!                                  "coh_duty", 0.53375, ...
+%!                                  "resampling", false, ...
+%!                                  "coh_c0_demod", 7.4e-8 / 1800, ...
+%!                                  "inc_c0", 4.7e-9, ...
+%!                                  "lattice", "Zn", ...
+%!                                  "boundaryType", "EaHCasA" ...
+%!                                );
+%!  cost0 = 3.1451 * EM2014;
+%!  TobsMax = 256.49 * DAYS;
+%!  TsegMax = 10 * DAYS;
+%!
+%!  sol_serial = OptimalSolution4StackSlide_v2 ( "costFuns", costFuns, "cost0", cost0, "TobsMax", TobsMax, "TsegMax", TsegMax, "stackparamsGuess", refParams, "memoDigits", 0 );
+%!  sol_memo = OptimalSolution4StackSlide_v2 ( "costFuns", costFuns, "cost0", cost0, "TobsMax", TobsMax, "TsegMax", TsegMax, "stackparamsGuess", refParams );
+%!  sol_forked = OptimalSolution4StackSlide_v2 ( "costFuns", costFuns, "cost0", cost0, "TobsMax", TobsMax, "TsegMax", TsegMax, "stackparamsGuess", refParams, "numProcs", 2 );
+%!
+%!  tol = -1e-6;
+%!  for sol = {sol_memo, sol_forked}
+%!    assert ( sol{1}.name, sol_serial.name );
+%!    assert ( sol{1}.Nseg, sol_serial.Nseg, tol );
+%!    assert ( sol{1}.Tseg, sol_serial.Tseg, tol );
+%!    assert ( sol{1}.mCoh, sol_serial.mCoh, tol );
+%!    assert ( sol{1}.mInc, sol_serial.mInc, tol );
+%!    assert ( [sol{1}.trialStats.iterations], [sol_serial.trialStats.iterations] );
+%!  endfor
+%!  assert ( numel ( sol_serial.trialStats ), 4 );
+%!  assert ( [sol_serial.trialStats.costEvals], [sol_serial.trialStats.costPoints] );
+%!  assert ( all ( [sol_memo.trialStats.costEvals] <= [sol_memo.trialStats.costPoints] ) );
+
 function [costCoh, costInc] = cost_wparams ( Nseg, Tseg, mCoh, mInc, params )
   ## coherent + incoherent cost functions
 
@@ -94,6 +94,15 @@
 ## @item nonlinearMismatch
 ## use empirical nonlinear mismatch relation instead of linear @samp{mis} = xi * m
 ##
+## @item numProcs
+## number of processes in which to run the solver trials (one per type of
+## constraint combination) concurrently; trials are run serially if 1 [default],
+## or if processes cannot be forked on this platform
+##
+## @item memoDigits
+## memoise evaluations of the cost function, keyed by its arguments rounded
+## to this many significant digits; set to 0 to disable [12]
+##
 ## @end table
 ##
 ## @heading Output
@@ -110,6 +119,14 @@
 ## @item m
 ## the optimal grid mismatch
 ##
+## @item trialStats
+## structure array of statistics for each solver trial: @code{name},
+## number of @code{iterations}, whether the solution @code{converged} and
+## was @code{feasible}, its objective function @code{L0}, number of calls
+## to the cost function @code{costCalls}, number of points requested
+## @code{costPoints} and actually evaluated @code{costEvals} (the remainder
+## being memoised), and @code{wallTime} and @code{cpuTime} in seconds
+##
 ## @end table
 ##
 ## @end deftypefn
@@ -135,6 +152,8 @@ function sol = OptimalSolution4StackSlide_v2 ( varargin )
                         {"minMismatch", "real,positive,scalar", 0 },
                         {"sensApprox", "char", "none" },
                         {"nonlinearMismatch", "logical,scalar", false },
+                        {"numProcs", "integer,strictpos,scalar", 1 },
+                        {"memoDigits", "integer,positive,scalar", 12 },
                         []);
 
   global powerEps; powerEps = 1e-5;     ## value practically considered "zero" for power-law coefficients
@@ -155,7 +174,12 @@ function sol = OptimalSolution4StackSlide_v2 ( varargin )
   endif
   constraints = struct ( "cost0", uvar.cost0, "TobsMax", uvar.TobsMax, "TsegMin", uvar.TsegMin, "TsegMax", uvar.TsegMax, "NsegMinSemi", 2 );
 
-  funs = OptimalSolution4StackSlide_v2_helpers ( uvar.costFuns, constraints, uvar.pFA, uvar.pFD, uvar.nonlinearMismatch, uvar.sensApprox );
+  ## count, and if requested memoise, evaluations of the cost function;
+  ## the memoised evaluations of the starting point are shared by all trials
+  costFuns = uvar.costFuns;
+  costFuns.f = memoCostFun ( "init", uvar.costFuns.f, uvar.memoDigits );
+
+  funs = OptimalSolution4StackSlide_v2_helpers ( costFuns, constraints, uvar.pFA, uvar.pFD, uvar.nonlinearMismatch, uvar.sensApprox );
 
   guess = uvar.stackparamsGuess;
   DebugPrintf ( 1, "Starting point ... ");
@@ -210,19 +234,28 @@ function sol = OptimalSolution4StackSlide_v2 ( varargin )
     trial{i}.startGuess = guess; trial{i}.startGuess.Tseg = constraints.TsegMin; trial{i}.startGuess.Nseg = constraints.TobsMax / trial{i}.startGuess.Tseg;
   endif
 
+  ## run solver trials, concurrently if requested
+  forked = ( uvar.numProcs > 1 && length(trial) > 1 && !ispc() );
+  if ( forked )
+    results = runTrialsForked ( trial, funs, uvar );
+  else
+    results = cell ( 1, length(trial) );
+    for i = 1:length(trial)
+      results{i} = runTrial ( trial{i}, funs, uvar );
+      reportTrial ( results{i}, constraints, uvar.tol );
+    endfor
+  endif
+
   best_solution = [];
+  trialStats = [];
   for i = 1:length(trial)
-    DebugPrintf ( 1, "------------------------------\n");
-    DebugPrintf ( 1, "Running solver %s:\n", sprintf("[%s]", trial{i}.name) );
-    sol_i = iterateSolver ( trial{i}.solverFun, trial{i}.startGuess, funs, uvar.tol, uvar.maxiter, uvar.hitmaxtimes, uvar.minMismatch );
-    DebugPrintf ( 1, "\n");
-    if ( isempty ( sol_i ) )
-      DebugPrintf ( 1, "%s: ", sprintf("[%s]", "FAILED")); DebugPrintf ( 1, "no solutions found\n" );
-    else
-      conv = ifelse ( sol_i.converged == 0, "maxiter", ifelse ( sol_i.converged == 1, "converged", "cyclical" ) );
-      DebugPrintf ( 1, "%s: ", sprintf("[%s]", conv)); DebugPrintStackparams ( 1, sol_i );
+    if ( forked )
+      reportTrial ( results{i}, constraints, uvar.tol );
+    endif
+    sol_i = results{i}.sol;
+    if ( !isempty ( sol_i ) )
       [ passed, msg] = checkConstraints ( sol_i, constraints, uvar.tol );
-      DebugPrintf ( 1, "==> %s\n", msg );
+      results{i}.stats.feasible = passed;
       if ( passed )
         if ( isempty ( best_solution ) || ( sol_i.L0 > best_solution.L0 ) )
           best_solution = sol_i;
@@ -230,9 +263,16 @@ function sol = OptimalSolution4StackSlide_v2 ( varargin )
         endif ## if new best solution
       endif ## if !constraints violated
     endif ## if solution found
-    DebugPrintf ( 1, "------------------------------\n");
+    trialStats = [ trialStats; results{i}.stats ];
   endfor ## i : length(trial)
 
+  DebugPrintf ( 1, "Solver trial statistics:\n" );
+  DebugPrintf ( 1, "%-16s %5s %8s %8s %8s %10s %10s\n", "trial", "iter", "calls", "points", "evals", "wall/s", "cpu/s" );
+  for i = 1:length(trialStats)
+    st = trialStats(i);
+    DebugPrintf ( 1, "%-16s %5d %8d %8d %8d %10.3g %10.3g\n", st.name, st.iterations, st.costCalls, st.costPoints, st.costEvals, st.wallTime, st.cpuTime );
+  endfor
+
   if ( !isempty ( best_solution  ) )
     DebugPrintf ( 1, "==============================\n");
     DebugPrintf ( 1, "--> Best solution found: [%s]: ", best_solution.name ); DebugPrintStackparams ( 1, best_solution ); DebugPrintf (1, "\n" );
@@ -245,11 +285,232 @@ function sol = OptimalSolution4StackSlide_v2 ( varargin )
 
   sol = best_solution;
   sol.funs = funs;
+  sol.trialStats = trialStats;
   return;
 
 endfunction ## OptimalSolution4StackSlide_v2()
 
-function sol = iterateSolver ( solverFun, startGuess, funs, tol, maxiter, hitmaxtimes, minMismatch )
+function result = runTrial ( trial, funs, uvar )
+  ## result = runTrial ( trial, funs, uvar )
+  ## run the solver from a single starting point, and collect statistics
+
+  DebugPrintf ( 1, "------------------------------\n");
+  DebugPrintf ( 1, "Running solver %s:\n", sprintf("[%s]", trial.name) );
+  costStats0 = memoCostFun ( "stats" );
+  wall0 = tic(); cpu0 = cputime();
+  [ sol, iterations ] = iterateSolver ( trial.solverFun, trial.startGuess, funs, uvar.tol, uvar.maxiter, uvar.hitmaxtimes, uvar.minMismatch );
+  cpuTime = cputime() - cpu0; wallTime = toc ( wall0 );
+  costStats = memoCostFun ( "stats" );
+  DebugPrintf ( 1, "\n");
+
+  result.sol = sol;
+  result.stats = struct ( "name", trial.name, ...
+                          "iterations", iterations, ...
+                          "converged", NaN, ...
+                          "feasible", false, ...
+                          "L0", NaN, ...
+                          "costCalls", costStats.calls - costStats0.calls, ...
+                          "costPoints", costStats.points - costStats0.points, ...
+                          "costEvals", costStats.evals - costStats0.evals, ...
+                          "wallTime", wallTime, ...
+                          "cpuTime", cpuTime );
+  if ( !isempty ( sol ) )
+    result.stats.converged = sol.converged;
+    result.stats.L0 = sol.L0;
+  endif
+
+  return;
+
+endfunction ## runTrial()
+
+function results = runTrialsForked ( trial, funs, uvar )
+  ## results = runTrialsForked ( trial, funs, uvar )
+  ## run the solver trials concurrently in up to 'uvar.numProcs' forked processes;
+  ## results are passed back to the parent process through temporary files
+
+  tmpdir = tempname();
+  [status, msg] = mkdir ( tmpdir );
+  assert ( status, "%s: could not create temporary directory '%s': %s", funcName, tmpdir, msg );
+  resultFile = @(i) fullfile ( tmpdir, sprintf ( "trial%i.bin", i ) );
+
+  results = cell ( 1, length(trial) );
+  master_pid = getpid();
+  pids = [];
+  unwind_protect
+
+    for i = 1:length(trial)
+
+      ## wait for a process to finish if all are busy
+      while ( length(pids) >= uvar.numProcs )
+        pid = waitpid ( -1 );
+        pids(pids == pid) = [];
+      endwhile
+
+      pid = fork();
+      if ( pid == 0 )
+        status = 1;
+        try
+          result = runTrial ( trial{i}, funs, uvar );
+          save ( "-binary", resultFile(i), "result" );
+          status = 0;
+        catch err
+          fprintf ( stderr, "error: %s\n", err.message );
+        end_try_catch
+        exit ( status );
+      elseif ( pid < 0 )
+        error ( "%s: could not fork process for solver trial [%s]", funcName, trial{i}.name );
+      endif
+      pids(end+1) = pid;
+
+    endfor
+
+    ## wait for remaining processes
+    for pid = pids
+      waitpid ( pid );
+    endfor
+    pids = [];
+
+    for i = 1:length(trial)
+      assert ( exist ( resultFile(i), "file" ) == 2, "%s: solver trial [%s] failed", funcName, trial{i}.name );
+      loaded = load ( resultFile(i) );
+      results{i} = loaded.result;
+    endfor
+
+  unwind_protect_cleanup
+    if ( getpid() == master_pid )
+      for pid = pids
+        kill ( pid, SIG().TERM );
+        waitpid ( pid );
+      endfor
+      for i = 1:length(trial)
+        if ( exist ( resultFile(i), "file" ) )
+          unlink ( resultFile(i) );
+        endif
+      endfor
+      rmdir ( tmpdir );
+    endif
+  end_unwind_protect
+
+  return;
+
+endfunction ## runTrialsForked()
+
+function reportTrial ( result, constraints, tol )
+  ## reportTrial ( result, constraints, tol )
+  ## print the outcome of a solver trial
+
+  sol_i = result.sol;
+  if ( isempty ( sol_i ) )
+    DebugPrintf ( 1, "%s: ", sprintf("[%s]", "FAILED")); DebugPrintf ( 1, "no solutions found\n" );
+  else
+    conv = ifelse ( sol_i.converged == 0, "maxiter", ifelse ( sol_i.converged == 1, "converged", "cyclical" ) );
+    DebugPrintf ( 1, "%s: ", sprintf("[%s]", conv)); DebugPrintStackparams ( 1, sol_i );
+    [ passed, msg] = checkConstraints ( sol_i, constraints, tol );
+    DebugPrintf ( 1, "==> %s\n", msg );
+  endif
+  DebugPrintf ( 1, "------------------------------\n");
+
+  return;
+
+endfunction ## reportTrial()
+
+function varargout = memoCostFun ( cmd, varargin )
+  ## f_memo = memoCostFun ( "init", f, digits )
+  ## stats = memoCostFun ( "stats" )
+  ## [ costCoh, costInc ] = memoCostFun ( "eval", f, id, Nseg, Tseg, mCoh, mInc )
+  ## wrap the cost function 'f' to count its evaluations, and if 'digits' > 0, memoise
+  ## them keyed by the arguments rounded to 'digits' significant digits; handles
+  ## returned by previous "init" calls continue to work, but are no longer memoised
+
+  persistent memo = struct ( "id", 0, "digits", 0, "table", [], "calls", 0, "points", 0, "evals", 0 );
+
+  switch cmd
+
+    case "init"
+      [ f, digits ] = deal ( varargin{:} );
+      memo.id += 1;
+      memo.digits = digits;
+      memo.table = containers.Map ( "KeyType", "char", "ValueType", "any" );
+      memo.calls = memo.points = memo.evals = 0;
+      id = memo.id;
+      varargout = { @(Nseg, Tseg, mCoh, mInc) memoCostFun ( "eval", f, id, Nseg, Tseg, mCoh, mInc ) };
+
+    case "stats"
+      varargout = { struct ( "calls", memo.calls, "points", memo.points, "evals", memo.evals ) };
+
+    case "eval"
+      [ f, id, Nseg, Tseg, mCoh, mInc ] = deal ( varargin{:} );
+      if ( id != memo.id )
+        [ costCoh, costInc ] = f ( Nseg, Tseg, mCoh, mInc );
+        varargout = { costCoh, costInc };
+        return;
+      endif
+
+      ## non-interpolating cost functions may be called with empty 'mCoh'
+      noCoh = isempty ( mCoh );
+      if ( noCoh )
+        mCohKey = NaN;
+      else
+        mCohKey = mCoh;
+      endif
+      [ err, Nseg, Tseg, mCohKey, mInc ] = common_size ( Nseg, Tseg, mCohKey, mInc );
+      assert ( err == 0, "%s: cost function arguments are not of common size", funcName );
+      memo.calls += 1;
+      memo.points += numel ( Nseg );
+
+      if ( memo.digits == 0 )
+        if ( noCoh )
+          [ costCoh, costInc ] = f ( Nseg, Tseg, [], mInc );
+        else
+          [ costCoh, costInc ] = f ( Nseg, Tseg, mCohKey, mInc );
+        endif
+        memo.evals += numel ( Nseg );
+        varargout = { costCoh, costInc };
+        return;
+      endif
+
+      ## look up memoised points
+      fmt = sprintf ( "%%.%ig,%%.%ig,%%.%ig,%%.%ig", memo.digits * ones(1, 4) );
+      keys = cell ( size ( Nseg ) );
+      for i = 1:numel(Nseg)
+        keys{i} = sprintf ( fmt, Nseg(i), Tseg(i), mCohKey(i), mInc(i) );
+      endfor
+      hit = isKey ( memo.table, keys );
+      costCoh = costInc = zeros ( size ( Nseg ) );
+      if ( any ( hit(:) ) )
+        costs = cell2mat ( reshape ( values ( memo.table, keys(hit) ), [], 1 ) );
+        costCoh(hit) = costs(:, 1);
+        costInc(hit) = costs(:, 2);
+      endif
+
+      ## evaluate each distinct remaining point once, in a single call
+      miss = find ( !hit );
+      if ( !isempty ( miss ) )
+        [ missKeys, ui, uj ] = unique ( keys(miss) );
+        ii = miss(ui);
+        if ( noCoh )
+          [ cc, ci ] = f ( Nseg(ii), Tseg(ii), [], mInc(ii) );
+        else
+          [ cc, ci ] = f ( Nseg(ii), Tseg(ii), mCohKey(ii), mInc(ii) );
+        endif
+        costCoh(miss) = cc(uj);
+        costInc(miss) = ci(uj);
+        for k = 1:numel(missKeys)
+          memo.table(missKeys{k}) = [ cc(k), ci(k) ];
+        endfor
+        memo.evals += numel ( ii );
+      endif
+
+      varargout = { costCoh, costInc };
+
+    otherwise
+      error ( "%s: unknown command '%s'", funcName, cmd );
+
+  endswitch
+
+endfunction ## memoCostFun()
+
+function [ sol, iter ] = iterateSolver ( solverFun, startGuess, funs, tol, maxiter, hitmaxtimes, minMismatch )
   global DAYS = 86400;
   sol = [];
 
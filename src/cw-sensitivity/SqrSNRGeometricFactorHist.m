@@ -77,6 +77,9 @@
 
 function Rsqr = SqrSNRGeometricFactorHist(varargin)
 
+  ## profile this function
+  prof = octapps_prof_scope(funcName);
+
   ## parse options
   [ dummy, uvar ] = parseOptions(varargin,
                {"T", "real,scalar", inf},
@@ -97,20 +100,31 @@ function Rsqr = SqrSNRGeometricFactorHist(varargin)
   assert(all(isalnum(detectors) | detectors == ","), ...
          "%s: invalid detectors '%s'", funcName, detectors);
 
-  ## handle caching of results
+  ## handle caching of results, using octapps_cache() if available; otherwise
+  ## results are saved to files in the cache directory, which are moved into
+  ## octapps_cache() when they are next looked up with octapps_cache() available
   uvar = rmfield ( uvar, "use_cache" );
-  ss = stringify ( orderfields ( uvar ) );
-  key = octapps_md5sum(ss);
-  cache_dir = mkpath(getenv("HOME"), ".cache", "octapps", "SqrSNRGeometricFactorHist");
-  cached_resfile = sprintf ("%s/%s", cache_dir, key );
+  key = octapps_md5sum ( stringify ( orderfields ( uvar ) ) );
+  have_cache = ( exist ( "octapps_cache" ) == 3 );
+  cache_dir = fullfile ( getenv("HOME"), ".cache", "octapps", "SqrSNRGeometricFactorHist" );
+  cached_resfile = fullfile ( cache_dir, key );
   if ( use_cache )
-    if ( exist ( cached_resfile, "file" ) )
-      uvar_in = uvar;
-      load ( cached_resfile );
-      if ( isequal ( uvar_in, uvar ) )	## make sure nothing gone wrong in hashing
-        return;
+    found = false;
+    if ( have_cache )
+      [ found, cached ] = octapps_cache ( "get", funcName, key );
+    endif
+    if ( !found && exist ( cached_resfile, "file" ) )
+      cached = load ( cached_resfile );
+      found = isfield ( cached, "Rsqr" ) && isfield ( cached, "uvar" );
+      if ( found && have_cache && isequal ( cached.uvar, uvar ) )
+        octapps_cache ( "put", funcName, key, struct ( "Rsqr", cached.Rsqr, "uvar", cached.uvar ) );
+        unlink ( cached_resfile );
       endif
     endif
+    if ( found && isequal ( cached.uvar, uvar ) )	## make sure nothing gone wrong in hashing
+      Rsqr = cached.Rsqr;
+      return;
+    endif
   endif
 
   ## product of angular sidereal frequency and observation time
@@ -200,7 +214,12 @@ function Rsqr = SqrSNRGeometricFactorHist(varargin)
   Rsqr = rescaleHistBins(Rsqr, 1.0 / apxnorm);
 
   ## always store new results in cache
-  save ("-binary", cached_resfile, "Rsqr", "uvar" );
+  if ( have_cache )
+    octapps_cache ( "put", funcName, key, struct ( "Rsqr", Rsqr, "uvar", uvar ) );
+  else
+    mkpath ( cache_dir );
+    save ( "-binary", cached_resfile, "Rsqr", "uvar" );
+  endif
 
 endfunction
 
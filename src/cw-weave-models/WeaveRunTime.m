@@ -122,6 +122,14 @@
 ##
 ## @end itemize
 ##
+## @heading Grid evaluation
+##
+## Any of the numeric options (except @var{TSFT}) may be given as vectors of a
+## common length, with scalars applying to all elements, to evaluate a grid of
+## search configurations in one call; the fields of @var{times} and @var{maxmem},
+## and @var{tau}.Fstat, are then column vectors with one element per configuration.
+## The F-statistic timing model is evaluated once for each distinct coherent search setup.
+##
 ## @end deftypefn
 
 ## octapps_run_link
@@ -131,24 +139,24 @@ function [times, maxmem, tau] = WeaveRunTime(varargin)
   ## parse options
   parseOptions(varargin,
                {"setup_file", "char", []},
-               {"Nsegments", "integer,strictpos,scalar,+exactlyone:setup_file", []},
-               {"Ndetectors", "integer,strictpos,scalar,+exactlyone:setup_file", []},
-               {"ref_time", "real,strictpos,scalar,+exactlyone:setup_file", []},
-               {"start_time", "real,strictpos,scalar,+exactlyone:setup_file", []},
-               {"coh_Tspan", "real,strictpos,scalar,+exactlyone:setup_file", []},
-               {"semi_Tspan", "real,strictpos,scalar,+exactlyone:setup_file", []},
+               {"Nsegments", "integer,strictpos,vector,+exactlyone:setup_file", []},
+               {"Ndetectors", "integer,strictpos,vector,+exactlyone:setup_file", []},
+               {"ref_time", "real,strictpos,vector,+exactlyone:setup_file", []},
+               {"start_time", "real,strictpos,vector,+exactlyone:setup_file", []},
+               {"coh_Tspan", "real,strictpos,vector,+exactlyone:setup_file", []},
+               {"semi_Tspan", "real,strictpos,vector,+exactlyone:setup_file", []},
                {"result_file", "char", []},
-               {"freq_min", "real,strictpos,scalar,+exactlyone:result_file", []},
-               {"freq_max", "real,strictpos,scalar,+exactlyone:result_file", []},
-               {"dfreq", "real,strictpos,scalar,+exactlyone:result_file", []},
-               {"f1dot_min", "real,scalar,+exactlyone:result_file", []},
-               {"f1dot_max", "real,scalar,+exactlyone:result_file", []},
-               {"f2dot_min", "real,scalar,+atmostone:result_file", 0},
-               {"f2dot_max", "real,scalar,+atmostone:result_file", 0},
+               {"freq_min", "real,strictpos,vector,+exactlyone:result_file", []},
+               {"freq_max", "real,strictpos,vector,+exactlyone:result_file", []},
+               {"dfreq", "real,strictpos,vector,+exactlyone:result_file", []},
+               {"f1dot_min", "real,vector,+exactlyone:result_file", []},
+               {"f1dot_max", "real,vector,+exactlyone:result_file", []},
+               {"f2dot_min", "real,vector,+atmostone:result_file", 0},
+               {"f2dot_max", "real,vector,+atmostone:result_file", 0},
                {"Fmethod", "char,+exactlyone:result_file", []},
-               {"Ncohres", "integer,strictpos,scalar,+exactlyone:result_file", []},
-               {"Nsemitpl", "integer,strictpos,scalar,+exactlyone:result_file", []},
-               {"cache_max", "integer,strictpos,scalar,+atmostone:result_file", []},
+               {"Ncohres", "integer,strictpos,vector,+exactlyone:result_file", []},
+               {"Nsemitpl", "integer,strictpos,vector,+exactlyone:result_file", []},
+               {"cache_max", "integer,strictpos,vector,+atmostone:result_file", []},
                {"stats", "char"},
                {"timings", "char", "default"},
                {"TSFT", "integer,strictpos,scalar", 1800},
@@ -229,14 +237,24 @@ function [times, maxmem, tau] = WeaveRunTime(varargin)
     Nsemitpl = result_hdr.nsemitpl;
     cache_max = result_hdr.cachemax;
   endif
-  Nsemiseg = Nsemitpl * Nsegments;
-  Nsemisegm = Nsemitpl * (Nsegments - 1);
+  have_cache_max = !isempty(cache_max);
+  if !have_cache_max
+    cache_max = 0;
+  endif
+
+  ## expand configurations to column vectors of common size
+  [err, Nsegments, Ndetectors, ref_time, start_time, coh_Tspan, semi_Tspan, freq_min, freq_max, dfreq, f1dot_min, f1dot_max, f2dot_min, f2dot_max, Ncohres, Nsemitpl, cache_max] = ...
+  common_size(Nsegments(:), Ndetectors(:), ref_time(:), start_time(:), coh_Tspan(:), semi_Tspan(:), freq_min(:), freq_max(:), dfreq(:), f1dot_min(:), f1dot_max(:), f2dot_min(:), f2dot_max(:), Ncohres(:), Nsemitpl(:), cache_max(:));
+  assert(err == 0, "%s: configuration options are not of common size", funcName);
+
+  Nsemiseg = Nsemitpl .* Nsegments;
+  Nsemisegm = Nsemitpl .* (Nsegments - 1);
   Nsemitoplists = Nsemitpl * length(stats);
 
   ## check parameter-space ranges
-  assert(freq_max >= freq_min);
-  assert(f1dot_max >= f1dot_min);
-  assert(f2dot_max >= f2dot_min);
+  assert(all(freq_max >= freq_min));
+  assert(all(f1dot_max >= f1dot_min));
+  assert(all(f2dot_max >= f2dot_min));
 
   ## estimate time to iterate over lattice tiling
   time_iter = tau.iter_psemi * Nsemitpl;
@@ -244,17 +262,20 @@ function [times, maxmem, tau] = WeaveRunTime(varargin)
   ## estimate time to perform nearest-neighbour lookup queries
   time_query = tau.query_psemi_pseg * Nsemiseg;
 
-  ## estimate coherent F-statistic time and memory usage
+  ## estimate coherent F-statistic time and memory usage,
+  ## once for each distinct coherent search setup
+  fstat_setups = [coh_Tspan, freq_min, freq_max - freq_min, dfreq, f1dot_min, f1dot_max - f1dot_min, f2dot_min, f2dot_max - f2dot_min, (ref_time - start_time) ./ semi_Tspan];
+  [fstat_setups, ~, fstat_setup_index] = unique(fstat_setups, "rows");
   args = struct;
-  args.Tcoh = coh_Tspan;
-  args.Freq0 = freq_min;
-  args.FreqBand = freq_max - freq_min;
-  args.dFreq = dfreq;
-  args.f1dot0 = f1dot_min;
-  args.f1dotBand = f1dot_max - f1dot_min;
-  args.f2dot0 = f2dot_min;
-  args.f2dotBand = f2dot_max - f2dot_min;
-  args.refTimeShift = (ref_time - start_time) / semi_Tspan;
+  args.Tcoh = fstat_setups(:, 1);
+  args.Freq0 = fstat_setups(:, 2);
+  args.FreqBand = fstat_setups(:, 3);
+  args.dFreq = fstat_setups(:, 4);
+  args.f1dot0 = fstat_setups(:, 5);
+  args.f1dotBand = fstat_setups(:, 6);
+  args.f2dot0 = fstat_setups(:, 7);
+  args.f2dotBand = fstat_setups(:, 8);
+  args.refTimeShift = fstat_setups(:, 9);
   args.tau0_coreLD = tau.demod_fstat_coreld;
   args.tau0_bufferLD = tau.demod_fstat_bufferld;
   args.tau0_Fbin = tau.resamp_fstat_fbin;
@@ -264,18 +285,19 @@ function [times, maxmem, tau] = WeaveRunTime(varargin)
   args.Nsft = 0;   # use default
   args.Tsft = TSFT;
   [resamp_info, demod_info] = fevalstruct(@predictFstatTimeAndMemory, args);
+  ii = fstat_setup_index(:);
   if strncmpi(Fmethod, "Resamp", 6)
-    tau.Fstat = resamp_info.tauF_core + tau.fstat_b * resamp_info.tauF_buffer;
-    maxmem.Fstat = resamp_info.MBWorkspace + resamp_info.MBDataPerDetSeg * Ndetectors * Nsegments;
+    tau.Fstat = resamp_info.tauF_core(ii) + tau.fstat_b * resamp_info.tauF_buffer(ii);
+    maxmem.Fstat = resamp_info.MBWorkspace(ii) + resamp_info.MBDataPerDetSeg(ii) .* Ndetectors .* Nsegments;
   elseif strncmpi(Fmethod, "Demod", 5)
-    tau.Fstat = demod_info.tauF_core + tau.fstat_b * demod_info.tauF_buffer;
-    maxmem.Fstat = demod_info.MBDataPerDetSeg * Ndetectors * Nsegments;
+    tau.Fstat = demod_info.tauF_core(ii) + tau.fstat_b * demod_info.tauF_buffer(ii);
+    maxmem.Fstat = demod_info.MBDataPerDetSeg(ii) .* Ndetectors .* Nsegments;
   else
     error("%s: unknown F-statistic method '%s'", funcName, Fmethod);
   endif
 
   ## estimate time to compute coherent F-statistics
-  time_coh2F = tau.Fstat * Ndetectors * Ncohres;
+  time_coh2F = tau.Fstat .* Ndetectors .* Ncohres;
 
   ## estimate time to compute semicoherent F-statistics
   time_sum2F = tau.semiseg_sum2f_psemi_psegm * Nsemisegm;
@@ -307,21 +329,21 @@ function [times, maxmem, tau] = WeaveRunTime(varargin)
       case "log10BSGL"
         times.coh_coh2f = time_coh2F;
         times.semiseg_sum2f = time_sum2F;
-        times.semiseg_sum2f_det = time_sum2F_det * Ndetectors;
+        times.semiseg_sum2f_det = time_sum2F_det .* Ndetectors;
         times.semi_log10bsgl = time_log10BSGL;
       case "log10BSGLtL"
         times.coh_coh2f = time_coh2F;
         times.semiseg_sum2f = time_sum2F;
-        times.semiseg_sum2f_det = time_sum2F_det * Ndetectors;
+        times.semiseg_sum2f_det = time_sum2F_det .* Ndetectors;
         times.semiseg_max2f = time_max2F;
-        times.semiseg_max2f_det = time_max2F_det * Ndetectors;
+        times.semiseg_max2f_det = time_max2F_det .* Ndetectors;
         times.semi_log10bsgltl = time_log10BSGLtL;
       case "log10BtSGLtL"
         times.coh_coh2f = time_coh2F;
         times.semiseg_sum2f = time_sum2F;
-        times.semiseg_sum2f_det = time_sum2F_det * Ndetectors;
+        times.semiseg_sum2f_det = time_sum2F_det .* Ndetectors;
         times.semiseg_max2f = time_max2F;
-        times.semiseg_max2f_det = time_max2F_det * Ndetectors;
+        times.semiseg_max2f_det = time_max2F_det .* Ndetectors;
         times.semi_log10btsgltl = time_log10BtSGLtL;
       otherwise
         error("%s: invalid statistic '%s'", funcName, stats{i});
@@ -330,9 +352,9 @@ function [times, maxmem, tau] = WeaveRunTime(varargin)
   times.output = time_output;
 
   ## estimate total run time
-  times.total = sum(structfun(@sum, times));
+  times.total = sum_fields(times);
 
-  if !isempty(cache_max)
+  if have_cache_max
 
     ## estimate maximum memory usage of components
     MB = 1024 * 1024;
@@ -356,17 +378,25 @@ function [times, maxmem, tau] = WeaveRunTime(varargin)
           error("%s: invalid statistic '%s'", funcName, stats{i});
       endswitch
     endfor
-    mem_cache_pbin = sum(structfun(@sum, mem_cache_pbin));
-    mem_cache_bins = (freq_max - freq_min) / dfreq;
-    maxmem.cache = cache_max * mem_cache_bins * mem_cache_pbin / MB;
+    mem_cache_pbin = sum_fields(mem_cache_pbin);
+    mem_cache_bins = (freq_max - freq_min) ./ dfreq;
+    maxmem.cache = cache_max .* mem_cache_bins .* mem_cache_pbin / MB;
 
     ## estimate maximum total memory usage
-    maxmem.total = sum(structfun(@sum, maxmem));
+    maxmem.total = sum_fields(maxmem);
 
   endif
 
 endfunction
 
+## sum the fields of a struct element-wise, i.e. separately for each configuration
+function total = sum_fields(s)
+  total = 0;
+  for [v, k] = s
+    total = total + v;
+  endfor
+endfunction
+
 %!test
 %!  try
 %!    lal; lalpulsar;
@@ -382,3 +412,36 @@ endfunction
 %!  assert(times.total > 0);
 %!  assert(maxmem.total > 0);
 %!  assert(all(structfun(@(t) t > 0, tau)));
+
+%!test
+%!  try
+%!    lal; lalpulsar;
+%!  catch
+%!    disp("skipping test: LALSuite bindings not available"); return;
+%!  end_try_catch
+%!  args = struct;
+%!  args.Nsegments = [10; 20; 10];
+%!  args.Ndetectors = 2;
+%!  args.ref_time = 1e9;
+%!  args.start_time = 1e9 - 10 * 86400;
+%!  args.coh_Tspan = [86400; 86400; 2 * 86400];
+%!  args.semi_Tspan = 20 * 86400;
+%!  args.freq_min = 50;
+%!  args.freq_max = 50.1;
+%!  args.dfreq = 1e-6;
+%!  args.f1dot_min = -1e-9;
+%!  args.f1dot_max = 0;
+%!  args.Fmethod = "ResampBest";
+%!  args.Ncohres = 1e8;
+%!  args.Nsemitpl = [1e10; 2e10; 1e10];
+%!  args.cache_max = 50;
+%!  args.stats = "mean2F,log10BSGL";
+%!  [times, maxmem] = fevalstruct(@WeaveRunTime, args);
+%!  assert(size(times.total), [3, 1]);
+%!  assert(size(maxmem.total), [3, 1]);
+%!  for n = 1:3
+%!    args_n = structfun(@(v) v(min(n, end), :), args, "UniformOutput", false);
+%!    [times_n, maxmem_n] = fevalstruct(@WeaveRunTime, args_n);
+%!    assert(times.total(n), times_n.total, -1e-10);
+%!    assert(maxmem.total(n), maxmem_n.total, -1e-10);
+%!  endfor
@@ -102,6 +102,18 @@
 ##
 ## @end table
 ##
+## @heading Grid evaluation
+##
+## The options @var{Nsegments}, @var{coh_Tspan}, @var{semi_Tspan},
+## @var{coh_max_mismatch}, @var{semi_max_mismatch}, @var{NSFTs}, and the
+## false alarm/dismissal options, may be given as vectors of a common length,
+## with scalars applying to all elements, to evaluate a grid of search
+## configurations in one call; @var{depth} is then a column vector with one
+## element per configuration, and @var{mismatch_hgrm} a column cell array of
+## histograms. Each distinct mismatch histogram is computed only once; if all
+## configurations share the same histogram, e.g. when only the false
+## alarm/dismissal options vary, @var{mismatch_hgrm} is that single histogram.
+##
 ## @end deftypefn
 
 ## octapps_run_link
@@ -112,16 +124,16 @@ function [depth, mismatch_hgrm] = WeaveSensDepth(varargin)
   parseOptions(varargin,
                {"setup_file", "char", []},
                {"detectors", "char,+exactlyone:setup_file", []},
-               {"Nsegments", "integer,strictpos,scalar,+exactlyone:setup_file", []},
-               {"coh_Tspan", "real,strictpos,scalar,+exactlyone:setup_file", []},
-               {"semi_Tspan", "real,strictpos,scalar,+exactlyone:setup_file,+noneorall:coh_Tspan", []},
+               {"Nsegments", "integer,strictpos,vector,+exactlyone:setup_file", []},
+               {"coh_Tspan", "real,strictpos,vector,+exactlyone:setup_file", []},
+               {"semi_Tspan", "real,strictpos,vector,+exactlyone:setup_file,+noneorall:coh_Tspan", []},
                {"alpha", "real,vector", []},
                {"delta", "real,vector,+noneorall:alpha", []},
                {"spindowns", "integer,positive,scalar"},
                {"lattice", "char", "Ans"},
-               {"coh_max_mismatch", "real,positive,scalar"},
-               {"semi_max_mismatch", "real,positive,scalar"},
-               {"NSFTs", "integer,strictpos,scalar"},
+               {"coh_max_mismatch", "real,positive,vector"},
+               {"semi_max_mismatch", "real,positive,vector"},
+               {"NSFTs", "integer,strictpos,vector"},
                {"pFD", "real,strictpos,column", 0.1},
                {"pFA", "real,strictpos,column,+exactlyone:mean2F_th", []},
                {"semi_ntmpl", "real,strictpos,column,+exactlyone:mean2F_th,+noneorall:pFA", []},
@@ -138,38 +150,62 @@ function [depth, mismatch_hgrm] = WeaveSensDepth(varargin)
     semi_Tspan = setup.semi_Tspan;
   endif
 
-  ## get mismatch histogram
-  args = struct;
-  if !isempty(setup_file)
-    args.setup_file = setup_file;
-  else
-    args.coh_Tspan = coh_Tspan;
-    args.semi_Tspan = semi_Tspan;
-  endif
-  args.sky = isempty(alpha);
-  args.spindowns = spindowns;
-  args.lattice = lattice;
-  args.coh_max_mismatch = coh_max_mismatch;
-  args.semi_max_mismatch = semi_max_mismatch;
-  mismatch_hgrm = fevalstruct(@WeaveFstatMismatch, args);
-
-  ## calculate sensitivity
-  args = struct;
-  args.Nseg = Nsegments;
-  args.Tdata = NSFTs * TSFT;
-  args.misHist = mismatch_hgrm;
-  args.detectors = detectors;
-  args.pFD = pFD;
+  ## expand configurations to column vectors of common size
   if !isempty(pFA)
-    args.pFA = pFA ./ semi_ntmpl;
+    FA = pFA ./ semi_ntmpl;
   else
-    args.avg2Fth = mean2F_th;
+    FA = mean2F_th;
   endif
-  if !isempty(alpha)
-    args.alpha = alpha;
-    args.delta = delta;
+  [err, Nsegments, coh_Tspan, semi_Tspan, coh_max_mismatch, semi_max_mismatch, NSFTs, pFD, FA] = ...
+  common_size(Nsegments(:), coh_Tspan(:), semi_Tspan(:), coh_max_mismatch(:), semi_max_mismatch(:), NSFTs(:), pFD(:), FA(:));
+  assert(err == 0, "%s: configuration options are not of common size", funcName);
+  N = length(FA);
+
+  ## group configurations which share the same mismatch histogram
+  [hgrm_keys, ~, hgrm_index] = unique([coh_Tspan, semi_Tspan, coh_max_mismatch, semi_max_mismatch], "rows");
+
+  depth = zeros(N, 1);
+  mismatch_hgrm = cell(N, 1);
+  for g = 1:rows(hgrm_keys)
+    ii = find(hgrm_index == g);
+
+    ## get mismatch histogram
+    args = struct;
+    if !isempty(setup_file)
+      args.setup_file = setup_file;
+    else
+      args.coh_Tspan = hgrm_keys(g, 1);
+      args.semi_Tspan = hgrm_keys(g, 2);
+    endif
+    args.sky = isempty(alpha);
+    args.spindowns = spindowns;
+    args.lattice = lattice;
+    args.coh_max_mismatch = hgrm_keys(g, 3);
+    args.semi_max_mismatch = hgrm_keys(g, 4);
+    mismatch_hgrm(ii) = {fevalstruct(@WeaveFstatMismatch, args)};
+
+    ## calculate sensitivity
+    args = struct;
+    args.Nseg = Nsegments(ii);
+    args.Tdata = NSFTs(ii) * TSFT;
+    args.misHist = mismatch_hgrm{ii(1)};
+    args.detectors = detectors;
+    args.pFD = pFD(ii);
+    if !isempty(pFA)
+      args.pFA = FA(ii);
+    else
+      args.avg2Fth = FA(ii);
+    endif
+    if !isempty(alpha)
+      args.alpha = alpha;
+      args.delta = delta;
+    endif
+    depth(ii) = fevalstruct(@SensitivityDepthStackSlide, args);
+
+  endfor
+  if rows(hgrm_keys) == 1
+    mismatch_hgrm = mismatch_hgrm{1};
   endif
-  depth = fevalstruct(@SensitivityDepthStackSlide, args);
 
 endfunction
 
@@ -190,3 +226,34 @@ endfunction
 %!  args.semi_ntmpl = results.primary.header.nsemitpl;
 %!  depth = fevalstruct(@WeaveSensDepth, args);
 %!  assert(depth, 29.573, 0.1);
+
+%!test
+%!  try
+%!    lal; lalpulsar;
+%!  catch
+%!    disp("skipping test: LALSuite bindings not available"); return;
+%!  end_try_catch
+%!  args = struct;
+%!  args.Nsegments = [10; 20; 10];
+%!  args.detectors = "H1,L1";
+%!  args.coh_Tspan = 86400;
+%!  args.semi_Tspan = [10; 20; 10] * 86400;
+%!  args.spindowns = 1;
+%!  args.coh_max_mismatch = 0.3;
+%!  args.semi_max_mismatch = [0.5; 0.5; 0.2];
+%!  args.NSFTs = [960; 1920; 960];
+%!  args.pFA = 0.01;
+%!  args.semi_ntmpl = 1e12;
+%!  [depth, mismatch_hgrm] = fevalstruct(@WeaveSensDepth, args);
+%!  assert(size(depth), [3, 1]);
+%!  assert(iscell(mismatch_hgrm) && numel(mismatch_hgrm) == 3);
+%!  for n = 1:3
+%!    args_n = structfun(@(v) v(min(n, end), :), args, "UniformOutput", false);
+%!    depth_n = fevalstruct(@WeaveSensDepth, args_n);
+%!    assert(depth(n), depth_n, -1e-10);
+%!  endfor
+%!  args = structfun(@(v) v(1, :), args, "UniformOutput", false);
+%!  args.pFA = [0.01; 0.001];
+%!  [depth, mismatch_hgrm] = fevalstruct(@WeaveSensDepth, args);
+%!  assert(size(depth), [2, 1]);
+%!  assert(isa(mismatch_hgrm, "Hist"));
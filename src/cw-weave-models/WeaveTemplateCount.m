@@ -100,6 +100,15 @@
 ##
 ## @end table
 ##
+## @heading Grid evaluation
+##
+## Any of the numeric options may be given as vectors of a common length, with
+## scalars applying to all elements, to evaluate a grid of search configurations
+## in one call; @var{coh_Nt}, @var{semi_Nt}, and @var{dfreq} are then column
+## vectors with one element per configuration. Configurations share ephemerides,
+## supersky metrics with the same segment setup, and template counts at common
+## nodes of the interpolation grid on @var{Nsegments} and @var{coh_Tspan}.
+##
 ## @end deftypefn
 
 ## octapps_run_link
@@ -109,25 +118,25 @@ function [coh_Nt, semi_Nt, dfreq] = WeaveTemplateCount(varargin)
   ## parse options
   parseOptions(varargin,
                {"setup_file", "char", []},
-               {"Nsegments", "real,strictpos,scalar,+exactlyone:setup_file", []},
+               {"Nsegments", "real,strictpos,vector,+exactlyone:setup_file", []},
                {"detectors", "char,+exactlyone:setup_file", []},
-               {"ref_time", "real,strictpos,scalar,+exactlyone:setup_file", []},
-               {"coh_Tspan", "real,strictpos,scalar,+exactlyone:setup_file", []},
-               {"semi_Tspan", "real,strictpos,scalar,+exactlyone:setup_file", []},
+               {"ref_time", "real,strictpos,vector,+exactlyone:setup_file", []},
+               {"coh_Tspan", "real,strictpos,vector,+exactlyone:setup_file", []},
+               {"semi_Tspan", "real,strictpos,vector,+exactlyone:setup_file", []},
                {"result_file", "char", []},
-               {"sky_area", "real,strictpos,scalar,+exactlyone:result_file", []},
-               {"freq_min", "real,strictpos,scalar,+exactlyone:result_file", []},
-               {"freq_max", "real,strictpos,scalar,+exactlyone:result_file", []},
-               {"f1dot_min", "real,scalar,+exactlyone:result_file", []},
-               {"f1dot_max", "real,scalar,+exactlyone:result_file", []},
-               {"f2dot_min", "real,scalar,+atmostone:result_file", 0},
-               {"f2dot_max", "real,scalar,+atmostone:result_file", 0},
-               {"coh_max_mismatch", "real,positive,scalar,+atmostone:result_file", []},
-               {"semi_max_mismatch", "real,positive,scalar,+atmostone:result_file", []},
+               {"sky_area", "real,strictpos,vector,+exactlyone:result_file", []},
+               {"freq_min", "real,strictpos,vector,+exactlyone:result_file", []},
+               {"freq_max", "real,strictpos,vector,+exactlyone:result_file", []},
+               {"f1dot_min", "real,vector,+exactlyone:result_file", []},
+               {"f1dot_max", "real,vector,+exactlyone:result_file", []},
+               {"f2dot_min", "real,vector,+atmostone:result_file", 0},
+               {"f2dot_max", "real,vector,+atmostone:result_file", 0},
+               {"coh_max_mismatch", "real,positive,vector,+atmostone:result_file", []},
+               {"semi_max_mismatch", "real,positive,vector,+atmostone:result_file", []},
                {"lattice", "char", "Ans"},
                []);
 
-  ## load ephemerides
+  ## load ephemerides, shared by all supersky metric computations
   ephemerides = loadEphemerides();
 
   interpolation = true;         ## default
@@ -161,37 +170,125 @@ function [coh_Nt, semi_Nt, dfreq] = WeaveTemplateCount(varargin)
       coh_max_mismatch = str2double(result_hdr.progarg_coh_max_mismatch);
     endif
   endif
-
-  if ( (Nsegments == 1) || isempty(coh_max_mismatch) || (coh_max_mismatch == 0) )
-    interpolation = false;
+  if isempty(coh_max_mismatch)
+    coh_max_mismatch = 0;
   endif
 
-  if ( !interpolation )
-    coh_max_mismatch = semi_max_mismatch;	## for XLALEqualizeReducedSuperskyMetricsFreqSpacing(), following Weave.c
-  endif
+  ## expand configurations to column vectors of common size
+  [err, Nsegments, ref_time, coh_Tspan, semi_Tspan, sky_area, freq_min, freq_max, f1dot_min, f1dot_max, f2dot_min, f2dot_max, coh_max_mismatch, semi_max_mismatch] = ...
+  common_size(Nsegments(:), ref_time(:), coh_Tspan(:), semi_Tspan(:), sky_area(:), freq_min(:), freq_max(:), f1dot_min(:), f1dot_max(:), f2dot_min(:), f2dot_max(:), coh_max_mismatch(:), semi_max_mismatch(:));
+  assert(err == 0, "%s: configuration options are not of common size", funcName);
+  Nconfig = length(Nsegments);
 
-  ## create frequency/spindown parameter space
-  fkdot_bands = [freq_max - freq_min; f1dot_max - f1dot_min];
-  if f2dot_min < f2dot_max
-    fkdot_bands = [fkdot_bands; f2dot_max - f2dot_min];
-  endif
-  fkdot_bands = [fkdot_bands(2:end, :); fkdot_bands(1, :)];
+  interpolation = interpolation & (Nsegments != 1) & (coh_max_mismatch != 0);
 
-  ## interpolation grid on number of segments
-  if Nsegments == round(Nsegments)
-    Nsegments_interp = Nsegments;
-  else
-    Nsegments_interp = unique(max(1, round(Nsegments) + (-1:1)));
-  endif
+  ## for XLALEqualizeReducedSuperskyMetricsFreqSpacing(), following Weave.c
+  coh_max_mismatch(!interpolation) = semi_max_mismatch(!interpolation);
+
+  ## frequency/spindown parameter-space bands; 2nd spindown band is zero if not searched
+  f2dot_band = f2dot_max - f2dot_min;
+  f2dot_band(!(f2dot_min < f2dot_max)) = 0;
+  config_keys = [semi_Tspan, ref_time, freq_max, sky_area, freq_max - freq_min, f1dot_max - f1dot_min, f2dot_band, coh_max_mismatch, semi_max_mismatch, interpolation];
 
-  ## interpolation grid on coherent timespan
+  ## interpolation grids on number of segments and coherent timespan; each grid
+  ## node is identified by a row of 'node_keys', so that nodes shared between
+  ## configurations are computed only once
   coh_Tspan_step = 21600;
-  if mod(coh_Tspan, coh_Tspan_step) == 0
-    coh_Tspan_interp = coh_Tspan;
-  else
-    coh_Tspan_min = 86400;
-    coh_Tspan_interp = unique(max(coh_Tspan_min, max(1, round(coh_Tspan / coh_Tspan_step) + (-1:1)) * coh_Tspan_step));
+  coh_Tspan_min = 86400;
+  Nsegments_interp = coh_Tspan_interp = node_index = cell(Nconfig, 1);
+  node_keys = zeros(9 * Nconfig, 2 + columns(config_keys));
+  Nnodes = 0;
+  for n = 1:Nconfig
+
+    ## interpolation grid on number of segments
+    if Nsegments(n) == round(Nsegments(n))
+      Nsegments_interp{n} = Nsegments(n);
+    else
+      Nsegments_interp{n} = unique(max(1, round(Nsegments(n)) + (-1:1)));
+    endif
+
+    ## interpolation grid on coherent timespan
+    if mod(coh_Tspan(n), coh_Tspan_step) == 0
+      coh_Tspan_interp{n} = coh_Tspan(n);
+    else
+      coh_Tspan_interp{n} = unique(max(coh_Tspan_min, max(1, round(coh_Tspan(n) / coh_Tspan_step) + (-1:1)) * coh_Tspan_step));
+    endif
+
+    ## add grid nodes
+    [Nsegments_node, coh_Tspan_node] = ndgrid(Nsegments_interp{n}, coh_Tspan_interp{n});
+    ii = Nnodes + (1:numel(Nsegments_node));
+    node_keys(ii, :) = [Nsegments_node(:), coh_Tspan_node(:), repmat(config_keys(n, :), numel(Nsegments_node), 1)];
+    node_index{n} = reshape(ii, size(Nsegments_node));
+    Nnodes += numel(Nsegments_node);
+
+  endfor
+  [node_keys, ~, node_map] = unique(node_keys(1:Nnodes, :), "rows");
+
+  ## compute number of templates at each unique grid node; supersky metrics are
+  ## shared between nodes with the same segment setup through the cache of
+  ## ComputeSuperskyMetrics()
+  metrics_cache_size = max(100, rows(unique(node_keys(:, 1:4), "rows")));
+  node_coh_Nt = node_semi_Nt = node_dfreq = zeros(rows(node_keys), 1);
+  for k = 1:rows(node_keys)
+    [node_coh_Nt(k), node_semi_Nt(k), node_dfreq(k)] = number_of_templates_at_node(node_keys(k, :), detectors, lattice, ephemerides, metrics_cache_size);
+  endfor
+
+  ## compute interpolated number of templates at requested Nsegments and coh_Tspan
+  coh_Nt = semi_Nt = dfreq = zeros(Nconfig, 1);
+  for n = 1:Nconfig
+    coh_Nt_interp = node_coh_Nt(node_map(node_index{n}));
+    semi_Nt_interp = node_semi_Nt(node_map(node_index{n}));
+    dfreq_interp = node_dfreq(node_map(node_index{n}));
+    if length(coh_Tspan_interp{n}) > 1
+      if length(Nsegments_interp{n}) > 1
+        coh_Nt(n) = ceil(interp2(coh_Tspan_interp{n}, Nsegments_interp{n}, coh_Nt_interp, coh_Tspan(n), max(1, Nsegments(n)), "spline"));
+        assert(!isnan(coh_Nt(n)), "%s: could not evaluate coh_Nt(Nsegments=%g, coh_Tspan=%g)", funcName, Nsegments(n), coh_Tspan(n));
+        semi_Nt(n) = ceil(interp2(coh_Tspan_interp{n}, Nsegments_interp{n}, semi_Nt_interp, coh_Tspan(n), max(1, Nsegments(n)), "spline"));
+        assert(!isnan(semi_Nt(n)), "%s: could not evaluate semi_Nt(Nsegments=%g, coh_Tspan=%g)", funcName, Nsegments(n), coh_Tspan(n));
+        dfreq(n) = interp2(coh_Tspan_interp{n}, Nsegments_interp{n}, dfreq_interp, coh_Tspan(n), max(1, Nsegments(n)), "spline");
+        assert(!isnan(dfreq(n)), "%s: could not evaluate dfreq(Nsegments=%g, coh_Tspan=%g)", funcName, Nsegments(n), coh_Tspan(n));
+      else
+        coh_Nt(n) = ceil(interp1(coh_Tspan_interp{n}, coh_Nt_interp, coh_Tspan(n), "spline"));
+        assert(!isnan(coh_Nt(n)), "%s: could not evaluate coh_Nt(coh_Tspan=%g)", funcName, coh_Tspan(n));
+        semi_Nt(n) = ceil(interp1(coh_Tspan_interp{n}, semi_Nt_interp, coh_Tspan(n), "spline"));
+        assert(!isnan(semi_Nt(n)), "%s: could not evaluate semi_Nt(coh_Tspan=%g)", funcName, coh_Tspan(n));
+        dfreq(n) = interp1(coh_Tspan_interp{n}, dfreq_interp, coh_Tspan(n), "spline");
+        assert(!isnan(dfreq(n)), "%s: could not evaluate dfreq(coh_Tspan=%g)", funcName, coh_Tspan(n));
+      endif
+    else
+      if length(Nsegments_interp{n}) > 1
+        coh_Nt(n) = ceil(interp1(Nsegments_interp{n}, coh_Nt_interp, Nsegments(n), "spline"));
+        assert(!isnan(coh_Nt(n)), "%s: could not evaluate coh_Nt(Nsegments=%g)", funcName, Nsegments(n));
+        semi_Nt(n) = ceil(interp1(Nsegments_interp{n}, semi_Nt_interp, Nsegments(n), "spline"));
+        assert(!isnan(semi_Nt(n)), "%s: could not evaluate semi_Nt(Nsegments=%g)", funcName, Nsegments(n));
+        dfreq(n) = interp1(Nsegments_interp{n}, dfreq_interp, Nsegments(n), "spline");
+        assert(!isnan(dfreq(n)), "%s: could not evaluate dfreq(Nsegments=%g)", funcName, Nsegments(n));
+      else
+        coh_Nt(n) = ceil(coh_Nt_interp);
+        assert(!isnan(coh_Nt(n)), "%s: could not evaluate coh_Nt", funcName);
+        semi_Nt(n) = ceil(semi_Nt_interp);
+        assert(!isnan(semi_Nt(n)), "%s: could not evaluate semi_Nt", funcName);
+        dfreq(n) = dfreq_interp;
+        assert(!isnan(dfreq(n)), "%s: could not evaluate dfreq", funcName);
+      endif
+    endif
+  endfor
+
+endfunction
+
+## compute the number of templates at a node of the interpolation grid
+function [coh_Nt, semi_Nt, dfreq] = number_of_templates_at_node(node_key, detectors, lattice, ephemerides, metrics_cache_size)
+
+  ## unpack node parameters; order must match 'node_keys'
+  node_key = num2cell(node_key);
+  [Nsegments, coh_Tspan, semi_Tspan, ref_time, freq_max, sky_area, freq_band, f1dot_band, f2dot_band, coh_max_mismatch, semi_max_mismatch, interpolation] = node_key{:};
+
+  ## create frequency/spindown parameter space
+  fkdot_bands = [freq_band; f1dot_band];
+  if f2dot_band > 0
+    fkdot_bands = [fkdot_bands; f2dot_band];
   endif
+  fkdot_bands = [fkdot_bands(2:end, :); fkdot_bands(1, :)];
 
   ## empirical factors used to scale number of templates to match output of Weave
   coh_Nt_scale = 1.436;
@@ -205,72 +302,31 @@ function [coh_Nt, semi_Nt, dfreq] = WeaveTemplateCount(varargin)
   Rpack  = LatticePackingRadius ( dim, lattice );
   spacing_correction = Rpack / Rcover;
 
-  ## compute interpolation grid for number of templates
-  coh_Nt_interp = semi_Nt_interp = dfreq_interp = zeros(length(Nsegments_interp), length(coh_Tspan_interp));
-  for i = 1:length(Nsegments_interp)
-    for j = 1:length(coh_Tspan_interp)
-
-      ## create segment list
-      segment_list = CreateSegmentList(ref_time, Nsegments_interp(i), coh_Tspan_interp(j), semi_Tspan, []);
-
-      ## compute supersky metrics
-      metrics = ComputeSuperskyMetrics("spindowns", size(fkdot_bands, 1) - 1, "segment_list", segment_list, "ref_time", ref_time, "fiducial_freq", freq_max, "detectors", detectors);
+  ## create segment list
+  segment_list = CreateSegmentList(ref_time, Nsegments, coh_Tspan, semi_Tspan, []);
 
-      ## equalise frequency spacing between coherent and semicoherent metrics
-      XLALEqualizeReducedSuperskyMetricsFreqSpacing(metrics, coh_max_mismatch, semi_max_mismatch);
+  ## compute supersky metrics
+  metrics = ComputeSuperskyMetrics("spindowns", size(fkdot_bands, 1) - 1, "segment_list", segment_list, "ref_time", ref_time, "fiducial_freq", freq_max, "detectors", detectors,
+                                   "ephemerides", ephemerides, "cache_size", metrics_cache_size);
 
-      ## compute number of semicoherent templates
-      semi_Nt_interp(i, j) = semi_Nt_scale * number_of_lattice_templates(lattice, metrics.semi_rssky_metric.data, semi_max_mismatch, sky_area, fkdot_bands);
+  ## equalise frequency spacing between coherent and semicoherent metrics
+  XLALEqualizeReducedSuperskyMetricsFreqSpacing(metrics, coh_max_mismatch, semi_max_mismatch);
 
-      ## compute number of coherent templates
-      for k = 1:metrics.num_segments
-        if ( interpolation )
-          coh_Nt_interp(i, j) += coh_Nt_scale * number_of_lattice_templates(lattice, metrics.coh_rssky_metric{k}.data, coh_max_mismatch, sky_area, fkdot_bands);
-        else
-          coh_Nt_interp(i, j) += semi_Nt_interp(i, j);
-        endif
-      endfor
+  ## compute number of semicoherent templates
+  semi_Nt = semi_Nt_scale * number_of_lattice_templates(lattice, metrics.semi_rssky_metric.data, semi_max_mismatch, sky_area, fkdot_bands);
 
-      ## compute frequency spacing
-      dfreq_interp(i, j) = 2 * spacing_correction * sqrt(semi_max_mismatch / metrics.semi_rssky_metric.data(end, end));
-
-    endfor
-  endfor
-
-  ## compute interpolated number of templates at requested Nsegments and coh_Tspan
-  if length(coh_Tspan_interp) > 1
-    if length(Nsegments_interp) > 1
-      coh_Nt = ceil(interp2(coh_Tspan_interp, Nsegments_interp, coh_Nt_interp, coh_Tspan, max(1, Nsegments), "spline"));
-      assert(!isnan(coh_Nt), "%s: could not evaluate coh_Nt(Nsegments=%g, coh_Tspan=%g)", funcName, Nsegments, coh_Tspan);
-      semi_Nt = ceil(interp2(coh_Tspan_interp, Nsegments_interp, semi_Nt_interp, coh_Tspan, max(1, Nsegments), "spline"));
-      assert(!isnan(semi_Nt), "%s: could not evaluate semi_Nt(Nsegments=%g, coh_Tspan=%g)", funcName, Nsegments, coh_Tspan);
-      dfreq = interp2(coh_Tspan_interp, Nsegments_interp, dfreq_interp, coh_Tspan, max(1, Nsegments), "spline");
-      assert(!isnan(dfreq), "%s: could not evaluate dfreq(Nsegments=%g, coh_Tspan=%g)", funcName, Nsegments, coh_Tspan);
-    else
-      coh_Nt = ceil(interp1(coh_Tspan_interp, coh_Nt_interp, coh_Tspan, "spline"));
-      assert(!isnan(coh_Nt), "%s: could not evaluate coh_Nt(coh_Tspan=%g)", funcName, coh_Tspan);
-      semi_Nt = ceil(interp1(coh_Tspan_interp, semi_Nt_interp, coh_Tspan, "spline"));
-      assert(!isnan(semi_Nt), "%s: could not evaluate semi_Nt(coh_Tspan=%g)", funcName, coh_Tspan);
-      dfreq = interp1(coh_Tspan_interp, dfreq_interp, coh_Tspan, "spline");
-      assert(!isnan(dfreq), "%s: could not evaluate dfreq(coh_Tspan=%g)", funcName, coh_Tspan);
-    endif
-  else
-    if length(Nsegments_interp) > 1
-      coh_Nt = ceil(interp1(Nsegments_interp, coh_Nt_interp, Nsegments, "spline"));
-      assert(!isnan(coh_Nt), "%s: could not evaluate coh_Nt(Nsegments=%g)", funcName, Nsegments);
-      semi_Nt = ceil(interp1(Nsegments_interp, semi_Nt_interp, Nsegments, "spline"));
-      assert(!isnan(semi_Nt), "%s: could not evaluate semi_Nt(Nsegments=%g)", funcName, Nsegments);
-      dfreq = interp1(Nsegments_interp, dfreq_interp, Nsegments, "spline");
-      assert(!isnan(dfreq), "%s: could not evaluate dfreq(Nsegments=%g)", funcName, Nsegments);
+  ## compute number of coherent templates
+  coh_Nt = 0;
+  for k = 1:metrics.num_segments
+    if ( interpolation )
+      coh_Nt += coh_Nt_scale * number_of_lattice_templates(lattice, metrics.coh_rssky_metric{k}.data, coh_max_mismatch, sky_area, fkdot_bands);
     else
-      coh_Nt = ceil(coh_Nt_interp);
-      assert(!isnan(coh_Nt), "%s: could not evaluate coh_Nt", funcName);
-      semi_Nt = ceil(semi_Nt_interp);
-      assert(!isnan(semi_Nt), "%s: could not evaluate semi_Nt", funcName);
-      dfreq = dfreq_interp;
-      assert(!isnan(dfreq), "%s: could not evaluate dfreq", funcName);
+      coh_Nt += semi_Nt;
     endif
-  endif
+  endfor
+
+  ## compute frequency spacing
+  dfreq = 2 * spacing_correction * sqrt(semi_max_mismatch / metrics.semi_rssky_metric.data(end, end));
 
 endfunction
 
@@ -317,3 +373,31 @@ endfunction
 %!  [coh_Nt, semi_Nt] = fevalstruct(@WeaveTemplateCount, args);
 %!  assert(coh_Nt, results.primary.header.ncohtpl, -0.2);
 %!  assert(semi_Nt, results.primary.header.nsemitpl, -0.2);
+
+%!test
+%!  try
+%!    lal; lalpulsar;
+%!  catch
+%!    disp("skipping test: LALSuite bindings not available"); return;
+%!  end_try_catch
+%!  args = struct;
+%!  args.Nsegments = [2, 3, 2.5];
+%!  args.detectors = "H1,L1";
+%!  args.ref_time = 1e9;
+%!  args.coh_Tspan = 86400;
+%!  args.semi_Tspan = 4 * 86400;
+%!  args.sky_area = 4*pi * 1e-3;
+%!  args.freq_min = 50;
+%!  args.freq_max = 50.01;
+%!  args.f1dot_min = -1e-10;
+%!  args.f1dot_max = 0;
+%!  args.coh_max_mismatch = 0.3;
+%!  args.semi_max_mismatch = 0.6;
+%!  [coh_Nt, semi_Nt, dfreq] = fevalstruct(@WeaveTemplateCount, args);
+%!  assert(size(coh_Nt), [3, 1]);
+%!  for n = 1:3
+%!    args_n = args;
+%!    args_n.Nsegments = args.Nsegments(n);
+%!    [coh_Nt_n, semi_Nt_n, dfreq_n] = fevalstruct(@WeaveTemplateCount, args_n);
+%!    assert([coh_Nt(n), semi_Nt(n), dfreq(n)], [coh_Nt_n, semi_Nt_n, dfreq_n]);
+%!  endfor
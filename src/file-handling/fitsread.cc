@@ -34,6 +34,8 @@
 
 #include <fitsio.h>
 
+#include "octapps_prof.hpp"
+
 extern "C" int fffree(void*, int *);
 
 static const char *const fitsread_usage = "-*- texinfo -*- \n\
@@ -75,6 +77,7 @@ DEFUN_DLD( fitsread, args, nargout, fitsread_usage ) {
     return octave_value();
   }
   std::string filename = args(0).string_value();
+  octapps_prof::scope prof("fitsread");
 
   // Open FITS file
   int status = 0;
@@ -86,11 +89,13 @@ DEFUN_DLD( fitsread, args, nargout, fitsread_usage ) {
 
     // Read all HDUs
     do {
+      octapps_prof::scope prof_hdu(prof, "fitsread:hdu");
 
       // Read HDU header
       octave_map header(dim_vector(1, 1));
       int nkeys = 0;
       fits_get_hdrspace(ff, &nkeys, 0, &status);
+      prof_hdu.count("fitsread:header_cards", nkeys);
       for (int i = 1; i <= nkeys; ++i) {
 
         // Read next header card and parse into keyword/value
@@ -179,6 +184,7 @@ DEFUN_DLD( fitsread, args, nargout, fitsread_usage ) {
       }
       if (fits_get_hdu_type(ff, &hdutype, &status) != 0) break;
       if (hdutype == IMAGE_HDU) {
+        octapps_prof::scope prof_data(prof_hdu, "fitsread:image");
 
         // Get image dimensions
         int bitpix = 0, naxis = 0;
@@ -213,10 +219,12 @@ DEFUN_DLD( fitsread, args, nargout, fitsread_usage ) {
           }
           if (status != 0) break;
           data = octave_value(array.squeeze());
+          prof_data.bytes(data.byte_size());
 
         }
 
       } else {
+        octapps_prof::scope prof_data(prof_hdu, "fitsread:table");
 
         // Get table dimensions and fields
         long nrows = 0;
@@ -285,6 +293,7 @@ DEFUN_DLD( fitsread, args, nargout, fitsread_usage ) {
 
         }
         data = octave_value(tbl);
+        prof_data.bytes(data.byte_size());
 
       }
 
@@ -0,0 +1,467 @@
+//
+// Copyright (C) 2026 Karl Wette
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with with program; see the file COPYING. If not, write to the
+// Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+// MA  02111-1307  USA
+//
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <octave/oct.h>
+#if OCTAVE_VERSION_HEX >= 0x040200
+#include <octave/interpreter.h>
+#else
+#include <octave/toplev.h>
+#endif
+
+#include "octcolfile.hpp"
+
+static const char *const octapps_cache_usage = "-*- texinfo -*- \n\
+@deftypefn {Loadable Function} { [ @var{found}, @var{value} ] =} octapps_cache ( \"get\", @var{store}, @var{key} )\n\
+@deftypefnx{Loadable Function} {} octapps_cache ( \"put\", @var{store}, @var{key}, @var{value} )\n\
+@deftypefnx{Loadable Function} {} octapps_cache ( \"config\", @var{store}, @var{opt}, @var{val}, @dots{} )\n\
+@deftypefnx{Loadable Function} {@var{stats} =} octapps_cache ( \"stats\" )\n\
+@deftypefnx{Loadable Function} {@var{stats} =} octapps_cache ( \"stats\", @var{store} )\n\
+@deftypefnx{Loadable Function} {} octapps_cache ( \"clear\", @var{store} )\n\
+\n\
+Cache of computed results, shared by all OctApps functions in an Octave process.\n\
+\n\
+Results are grouped into named @var{store}s (usually the name of the function \
+which computes them), and are addressed by a string @var{key}, usually computed \
+from the inputs to the function, e.g. \
+@code{@var{key} = octapps_md5sum(stringify(@var{inputs}))}.\n\
+\n\
+Each @var{store} keeps recently-used results in memory, evicting the least-recently \
+used results once it holds more than a maximum number of results or bytes. \
+Results may also be kept on disk, in the directory @file{$OCTAPPS_CACHE_DIR/@var{store}} \
+(default: @file{~/.cache/octapps/@var{store}}), in the OctCol format (see \
+@command{octcolwrite()}). Results are written to disk under a temporary name and \
+then renamed, so many processes (e.g. Condor jobs sharing a home directory) can \
+safely read and write the same @var{store} without locking; results are read \
+back from disk by memory-mapping the file. Results which cannot be written in \
+the OctCol format (e.g. SWIG objects) are kept only in memory.\n\
+\n\
+@table @code\n\
+@item get\n\
+Look up @var{key} in @var{store}, first in memory and then on disk; returns \
+whether the result was @var{found}, and its @var{value}.\n\
+\n\
+@item put\n\
+Add the result @var{value} for @var{key} to @var{store}.\n\
+\n\
+@item config\n\
+Configure @var{store}; options @var{opt} are:\n\
+@table @code\n\
+@item max_entries\n\
+maximum number of results kept in memory [default: 100]\n\
+@item max_bytes\n\
+maximum size of results kept in memory [default: 256 MiB]; sizes are as \
+reported by @command{sizeof()}, which is zero for SWIG objects, so results \
+which are SWIG objects are bounded only by @var{max_entries}\n\
+@item disk\n\
+if true [default], keep results on disk\n\
+@end table\n\
+\n\
+@item stats\n\
+Return a struct array of statistics for each (or the given) @var{store}: \
+the number and size of results in memory (@var{entries}, @var{bytes}), the number \
+of results found in memory (@var{hits}) and on disk (@var{disk_hits}), not found \
+(@var{misses}), evicted from memory (@var{evictions}), added (@var{puts}), and \
+written to disk (@var{disk_writes}), and the number of disk errors (@var{disk_errors}).\n\
+\n\
+@item clear\n\
+Remove all results in @var{store} from memory, and reset its statistics. \
+The configuration of @var{store} is kept, and results on disk are not removed.\n\
+@end table\n\
+\n\
+@end deftypefn";
+
+// Result kept in memory
+struct cache_entry {
+  octave_value value;
+  size_t bytes;
+  std::list<std::string>::iterator lru;
+};
+
+// Named store of results, with statistics
+struct cache_store {
+  size_t max_entries;
+  size_t max_bytes;
+  bool disk;
+  std::map<std::string, cache_entry> entries;
+  std::list<std::string> lru;
+  size_t bytes;
+  uint64_t hits, disk_hits, misses, evictions, puts, disk_writes, disk_errors;
+  cache_store()
+    : max_entries(100), max_bytes(256 << 20), disk(true), bytes(0),
+      hits(0), disk_hits(0), misses(0), evictions(0), puts(0), disk_writes(0), disk_errors(0)
+  { }
+};
+
+static std::map<std::string, cache_store> stores;
+
+// Check that store names and keys can be safely used as file names
+static bool valid_name(const std::string& name, bool allow_punct) {
+  if (name.empty() || name[0] == '.') {
+    return false;
+  }
+  for (size_t i = 0; i < name.size(); ++i) {
+    const char c = name[i];
+    if (!(isalnum(c) || c == '_' || (allow_punct && (c == '-' || c == '.')))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Create a directory and its parents, if they do not exist
+static bool make_dirs(const std::string& dir) {
+  for (size_t i = 1; i <= dir.size(); ++i) {
+    if (i == dir.size() || dir[i] == '/') {
+      const std::string d = dir.substr(0, i);
+      if (mkdir(d.c_str(), 0777) != 0 && errno != EEXIST) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Directory of a store on disk
+static std::string store_dir(const std::string& store) {
+  const char *root = getenv("OCTAPPS_CACHE_DIR");
+  if (root != 0 && *root != '\0') {
+    return std::string(root) + "/" + store;
+  }
+  const char *home = getenv("HOME");
+  return std::string(home != 0 ? home : ".") + "/.cache/octapps/" + store;
+}
+
+// File holding a result on disk; results are spread over subdirectories
+// named by the first 2 characters of their keys
+static std::string result_file(const std::string& store, const std::string& key) {
+  return store_dir(store) + "/" + key.substr(0, 2) + "/" + key + ".col";
+}
+
+// Evict least-recently-used results from memory until the store is within its
+// limits; the most recently-used result is always kept, unless max_entries == 0
+static void evict(cache_store& s) {
+  const size_t keep = std::min<size_t>(s.max_entries, 1);
+  while (s.entries.size() > keep && (s.entries.size() > s.max_entries || s.bytes > s.max_bytes)) {
+    std::map<std::string, cache_entry>::iterator q = s.entries.find(s.lru.back());
+    s.bytes -= q->second.bytes;
+    s.entries.erase(q);
+    s.lru.pop_back();
+    ++s.evictions;
+  }
+}
+
+// Add a result to memory
+static void add_to_memory(cache_store& s, const std::string& key, const octave_value& value) {
+  std::map<std::string, cache_entry>::iterator p = s.entries.find(key);
+  if (p != s.entries.end()) {
+    s.bytes -= p->second.bytes;
+    s.lru.erase(p->second.lru);
+    s.entries.erase(p);
+  }
+  cache_entry e;
+  e.value = value;
+  e.bytes = value.byte_size();
+  s.lru.push_front(key);
+  e.lru = s.lru.begin();
+  s.entries[key] = e;
+  s.bytes += e.bytes;
+  evict(s);
+}
+
+// Names of statistics returned by octapps_cache("stats")
+static const char *const stat_names[] = {
+  "entries", "bytes", "max_entries", "max_bytes", "disk",
+  "hits", "disk_hits", "misses", "evictions", "puts", "disk_writes", "disk_errors"
+};
+
+// Return statistics of a store
+static std::vector<double> store_stats(const cache_store& s) {
+  const double stats[] = {
+    (double) s.entries.size(), (double) s.bytes, (double) s.max_entries, (double) s.max_bytes, (double) s.disk,
+    (double) s.hits, (double) s.disk_hits, (double) s.misses, (double) s.evictions, (double) s.puts, (double) s.disk_writes, (double) s.disk_errors
+  };
+  return std::vector<double>(stats, stats + sizeof(stats) / sizeof(stats[0]));
+}
+
+DEFUN_DLD( octapps_cache, args, nargout, octapps_cache_usage ) {
+
+  // Prevent octave from crashing ...
+#if OCTAVE_VERSION_HEX < 0x040400
+  octave_exit = ::_Exit;
+#endif
+
+  // Check input and output
+  if (args.length() < 1 || !args(0).is_string()) {
+    print_usage();
+    return octave_value();
+  }
+  const std::string cmd = args(0).string_value();
+
+  if (cmd == "stats") {
+
+    // Return statistics of all stores, or of the given store
+    if (args.length() > 2 || (args.length() == 2 && !args(1).is_string())) {
+      error("usage: stats = octapps_cache(\"stats\"[, store])");
+      return octave_value();
+    }
+    std::vector<std::string> names;
+    for (std::map<std::string, cache_store>::const_iterator p = stores.begin(); p != stores.end(); ++p) {
+      if (args.length() == 1 || p->first == args(1).string_value()) {
+        names.push_back(p->first);
+      }
+    }
+    const size_t nstats = sizeof(stat_names) / sizeof(stat_names[0]);
+    std::vector<Cell> fields(nstats + 1, Cell(1, names.size()));
+    for (size_t i = 0; i < names.size(); ++i) {
+      const std::vector<double> stats = store_stats(stores[names[i]]);
+      fields[0](i) = octave_value(names[i]);
+      for (size_t j = 0; j < nstats; ++j) {
+        fields[j + 1](i) = octave_value(stats[j]);
+      }
+    }
+    octave_map stats(dim_vector(1, names.size()));
+    stats.setfield("store", fields[0]);
+    for (size_t j = 0; j < nstats; ++j) {
+      stats.setfield(stat_names[j], fields[j + 1]);
+    }
+    return octave_value(stats);
+
+  }
+
+  // Get store
+  if (args.length() < 2 || !args(1).is_string()) {
+    error("argument #2 is not a string");
+    return octave_value();
+  }
+  const std::string store = args(1).string_value();
+  if (!valid_name(store, false)) {
+    error("invalid store name '%s'", store.c_str());
+    return octave_value();
+  }
+  cache_store& s = stores[store];
+
+  if (cmd == "get" || cmd == "put") {
+
+    // Get key
+    if (args.length() != (cmd == "get" ? 3 : 4) || !args(2).is_string()) {
+      error("usage: [found, value] = octapps_cache(\"get\", store, key) or octapps_cache(\"put\", store, key, value)");
+      return octave_value();
+    }
+    const std::string key = args(2).string_value();
+    if (key.length() < 3 || !valid_name(key, true)) {
+      error("invalid key '%s'", key.c_str());
+      return octave_value();
+    }
+
+    if (cmd == "get") {
+      octave_value_list retval;
+
+      // Look up result in memory
+      std::map<std::string, cache_entry>::iterator p = s.entries.find(key);
+      if (p != s.entries.end()) {
+        s.lru.splice(s.lru.begin(), s.lru, p->second.lru);
+        ++s.hits;
+        retval(0) = true;
+        retval(1) = p->second.value;
+        return retval;
+      }
+
+      // Look up result on disk; corrupted files are removed
+      if (s.disk) {
+        const std::string filename = result_file(store, key);
+        if (access(filename.c_str(), F_OK) == 0) {
+          try {
+            octcol_reader reader;
+            reader.open(filename);
+            reader.selects[0].all = true;
+            octave_value S = reader.decode(0, &reader.selects[0]);
+            octave_map m = S.map_value();
+            if (!m.isfield("value")) {
+              throw octcol_error("file does not contain a cached result");
+            }
+            octave_value value = m.contents("value")(0);
+            add_to_memory(s, key, value);
+            ++s.disk_hits;
+            retval(0) = true;
+            retval(1) = value;
+            return retval;
+          } catch (const octcol_io_error& e) {
+            // file could not be opened or mapped, e.g. transiently; treat as a miss
+            ++s.disk_errors;
+          } catch (const octcol_error& e) {
+            // file is corrupted; remove it, and treat as a miss
+            ++s.disk_errors;
+            unlink(filename.c_str());
+          } catch (const std::bad_alloc& e) {
+            // file is corrupted, e.g. with implausible array sizes; remove it, and treat as a miss
+            ++s.disk_errors;
+            unlink(filename.c_str());
+          } catch (const std::exception& e) {
+            // result could not be rebuilt, e.g. its class is not on the Octave path;
+            // keep the file, which may be usable by other processes, and treat as a miss
+            ++s.disk_errors;
+          }
+        }
+      }
+
+      ++s.misses;
+      retval(0) = false;
+      retval(1) = Matrix();
+      return retval;
+
+    } else {
+
+      // Add result to memory
+      const octave_value& value = args(3);
+      add_to_memory(s, key, value);
+      ++s.puts;
+
+      // Add result to disk, unless it is already there, e.g. written by another process;
+      // results which cannot be written in the OctCol format are kept only in memory
+      if (s.disk) {
+        const std::string filename = result_file(store, key);
+        if (access(filename.c_str(), F_OK) != 0) {
+          octcol_writer writer(octcol_codec_value("auto"));
+          octave_map m(dim_vector(1, 1));
+          m.setfield("value", Cell(value));
+          try {
+            writer.add_map("", m, "");
+          } catch (const octcol_error& e) {
+            return octave_value_list();
+          }
+          try {
+            const std::string dir = filename.substr(0, filename.rfind('/'));
+            if (!make_dirs(dir)) {
+              throw octcol_error("could not create directory '" + dir + "'");
+            }
+            writer.write(filename);
+            ++s.disk_writes;
+          } catch (const octcol_error& e) {
+            ++s.disk_errors;
+            warning("octapps_cache: could not write '%s': %s", filename.c_str(), e.what());
+          }
+        }
+      }
+
+      return octave_value_list();
+
+    }
+
+  } else if (cmd == "config") {
+
+    // Configure store
+    if (args.length() % 2 != 0) {
+      error("usage: octapps_cache(\"config\", store, opt, val, ...)");
+      return octave_value();
+    }
+    for (octave_idx_type i = 2; i < args.length(); i += 2) {
+      const std::string opt = args(i).is_string() ? args(i).string_value() : "";
+      const octave_value& val = args(i+1);
+      if (opt == "max_entries" && val.is_real_scalar() && val.double_value() >= 0) {
+        s.max_entries = (size_t) val.double_value();
+      } else if (opt == "max_bytes" && val.is_real_scalar() && val.double_value() >= 0) {
+        s.max_bytes = (size_t) val.double_value();
+      } else if (opt == "disk" && val.is_scalar_type()) {
+        s.disk = val.bool_value();
+      } else {
+        error("invalid option #%li for octapps_cache(\"config\", ...)", (long) (i - 1) / 2);
+        return octave_value();
+      }
+    }
+    evict(s);
+    return octave_value_list();
+
+  } else if (cmd == "clear") {
+
+    // Clear store
+    if (args.length() != 2) {
+      error("usage: octapps_cache(\"clear\", store)");
+      return octave_value();
+    }
+    // Remove results from memory and reset statistics, keeping the configuration of the store
+    std::map<std::string, cache_store>::iterator p = stores.find(store);
+    if (p != stores.end()) {
+      cache_store s;
+      s.max_entries = p->second.max_entries;
+      s.max_bytes = p->second.max_bytes;
+      s.disk = p->second.disk;
+      p->second = s;
+    }
+    return octave_value_list();
+
+  }
+
+  error("unknown command '%s'", cmd.c_str());
+  return octave_value();
+
+}
+
+/*
+
+%!test
+%!  cache_dir = getenv("OCTAPPS_CACHE_DIR");
+%!  setenv("OCTAPPS_CACHE_DIR", tempname(tempdir));
+%!  unwind_protect
+%!    octapps_cache("clear", "test");
+%!    octapps_cache("config", "test", "max_entries", 2, "disk", true);
+%!    key = octapps_md5sum(stringify({1, "a"}));
+%!    [found, value] = octapps_cache("get", "test", key);
+%!    assert(!found);
+%!    hgrm = addDataToHist(Hist(1, {"lin", "dbin", 0.1}), rand(100, 1));
+%!    octapps_cache("put", "test", key, struct("x", 1:3, "hgrm", hgrm));
+%!    [found, value] = octapps_cache("get", "test", key);
+%!    assert(found);
+%!    assert(isequal(value.x, 1:3));
+%!    octapps_cache("put", "test", "key2", 2);
+%!    octapps_cache("put", "test", "key3", 3);
+%!    stats = octapps_cache("stats", "test");
+%!    assert([stats.entries, stats.hits, stats.misses, stats.evictions, stats.puts, stats.disk_writes], [2, 1, 1, 1, 3, 3]);
+%!    [found, value] = octapps_cache("get", "test", key);
+%!    assert(found);
+%!    assert(isa(value.hgrm, "Hist"));
+%!    assert(histTotalCount(value.hgrm) == 100);
+%!    stats = octapps_cache("stats", "test");
+%!    assert(stats.disk_hits == 1);
+%!    octapps_cache("config", "test", "disk", false);
+%!    octapps_cache("put", "test", "key4", @sin);
+%!    [found, value] = octapps_cache("get", "test", "key4");
+%!    assert(found && is_function_handle(value));
+%!  unwind_protect_cleanup
+%!    confirm_recursive_rmdir(false, "local");
+%!    rmdir(getenv("OCTAPPS_CACHE_DIR"), "s");
+%!    setenv("OCTAPPS_CACHE_DIR", cache_dir);
+%!    ## clearing the store keeps its configuration
+%!    octapps_cache("clear", "test");
+%!    stats = octapps_cache("stats", "test");
+%!    assert([stats.entries, stats.puts, stats.max_entries, stats.disk], [0, 0, 2, 0]);
+%!  end_unwind_protect
+
+%!error octapps_cache("get", "test", "../x")
+%!error octapps_cache("get", "te/st", "key")
+
+*/
@@ -0,0 +1,854 @@
+//
+// Copyright (C) 2026 Karl Wette
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with with program; see the file COPYING. If not, write to the
+// Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+// MA  02111-1307  USA
+//
+
+// Definitions shared by octcolwrite(), octcolread(), and octapps_cache(), which
+// write/read the OctApps column-block ("OctCol") file format. An OctCol file
+// consists of:
+//
+//   * a fixed-size header: magic string, byte-order mark, format version,
+//     and the number of entries and size of the index which follows;
+//
+//   * an index, which describes the saved values as a tree of entries
+//     stored in pre-order: a scalar struct at the root, whose fields may be
+//     cell arrays, struct arrays, old-style class objects, or typed arrays;
+//
+//   * a sequence of data blocks, one per typed array, each of which holds the
+//     array elements in column-major order, and which may be compressed.
+//
+// Since the index gives the offset of every data block, readers can load
+// selected values without reading or decompressing any other data block.
+
+#ifndef _OCTCOLFILE_HPP
+#define _OCTCOLFILE_HPP
+
+#include <cstdio>
+#include <cstdlib>
+#include <cctype>
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+#include <stdint.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
+#include <octave/oct.h>
+#include <octave/ov-class.h>
+#include <octave/Cell.h>
+
+#if OCTAVE_VERSION_HEX <= 0x030204
+#define octave_map Octave_map
+#endif
+
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+#ifdef HAVE_LZ4
+#include <lz4.h>
+#endif
+
+// File magic string and format version
+#define OCTCOL_MAGIC   "OCTCOL\r\n"
+#define OCTCOL_BOM     0x01020304
+#define OCTCOL_VERSION 1
+
+// Data blocks smaller than this are never compressed
+#define OCTCOL_MIN_COMPRESS 64
+
+// Maximum nesting depth of cell arrays/structs in an index
+#define OCTCOL_MAX_DEPTH 256
+
+// Kinds of index entries
+enum octcol_kind {
+  OCTCOL_ARRAY = 0,
+  OCTCOL_CELL = 1,
+  OCTCOL_STRUCT = 2,
+  OCTCOL_OBJECT = 3
+};
+
+// Element types of typed arrays
+enum octcol_type {
+  OCTCOL_DOUBLE = 0,
+  OCTCOL_SINGLE,
+  OCTCOL_COMPLEX,
+  OCTCOL_FLOAT_COMPLEX,
+  OCTCOL_INT8,
+  OCTCOL_INT16,
+  OCTCOL_INT32,
+  OCTCOL_INT64,
+  OCTCOL_UINT8,
+  OCTCOL_UINT16,
+  OCTCOL_UINT32,
+  OCTCOL_UINT64,
+  OCTCOL_LOGICAL,
+  OCTCOL_CHAR_SQ,
+  OCTCOL_CHAR_DQ,
+  OCTCOL_NUM_TYPES
+};
+
+// Compression codecs of data blocks
+enum octcol_codec {
+  OCTCOL_NONE = 0,
+  OCTCOL_ZSTD = 1,
+  OCTCOL_LZ4 = 2
+};
+
+// Errors raised while writing/reading OctCol files
+class octcol_error : public std::runtime_error {
+public:
+  octcol_error(const std::string& msg) : std::runtime_error(msg) { }
+};
+
+// Errors raised when an OctCol file cannot be opened, as opposed to being corrupted
+class octcol_io_error : public octcol_error {
+public:
+  octcol_io_error(const std::string& msg) : octcol_error(msg) { }
+};
+
+// Errors raised when a selector does not match the contents of an OctCol file
+class octcol_select_error : public octcol_error {
+public:
+  octcol_select_error(const std::string& msg) : octcol_error(msg) { }
+};
+
+// Size in bytes of each element type
+inline size_t octcol_type_size(int type) {
+  static const size_t sizes[OCTCOL_NUM_TYPES] = {
+    8, 4, 16, 8, 1, 2, 4, 8, 1, 2, 4, 8, 1, 1, 1
+  };
+  if (type < 0 || type >= OCTCOL_NUM_TYPES) {
+    throw octcol_error("invalid element type in index");
+  }
+  return sizes[type];
+}
+
+// Convert codec names to/from codec values
+inline int octcol_codec_value(const std::string& name) {
+  if (name == "none") {
+    return OCTCOL_NONE;
+  }
+  if (name == "zstd") {
+#ifdef HAVE_ZSTD
+    return OCTCOL_ZSTD;
+#else
+    throw octcol_error("codec 'zstd' is not available; OctApps was built without libzstd");
+#endif
+  }
+  if (name == "lz4") {
+#ifdef HAVE_LZ4
+    return OCTCOL_LZ4;
+#else
+    throw octcol_error("codec 'lz4' is not available; OctApps was built without liblz4");
+#endif
+  }
+  if (name == "auto") {
+#if defined(HAVE_ZSTD)
+    return OCTCOL_ZSTD;
+#elif defined(HAVE_LZ4)
+    return OCTCOL_LZ4;
+#else
+    return OCTCOL_NONE;
+#endif
+  }
+  throw octcol_error("unknown codec '" + name + "'");
+}
+inline std::string octcol_codec_name(int codec) {
+  switch (codec) {
+  case OCTCOL_NONE:
+    return "none";
+  case OCTCOL_ZSTD:
+    return "zstd";
+  case OCTCOL_LZ4:
+    return "lz4";
+  default:
+    return "unknown";
+  }
+}
+
+// Compress a data block; returns false if the block should be stored uncompressed
+inline bool octcol_compress(int codec, const char *src, size_t len, std::string& dst) {
+  if (len < OCTCOL_MIN_COMPRESS) {
+    return false;
+  }
+  switch (codec) {
+#ifdef HAVE_ZSTD
+  case OCTCOL_ZSTD: {
+    dst.resize(ZSTD_compressBound(len));
+    size_t n = ZSTD_compress(&dst[0], dst.size(), src, len, 3);
+    if (ZSTD_isError(n) || n >= len) {
+      return false;
+    }
+    dst.resize(n);
+    return true;
+  }
+#endif
+#ifdef HAVE_LZ4
+  case OCTCOL_LZ4: {
+    if (len > (size_t) LZ4_MAX_INPUT_SIZE) {
+      return false;
+    }
+    dst.resize(LZ4_compressBound((int) len));
+    int n = LZ4_compress_default(src, &dst[0], (int) len, (int) dst.size());
+    if (n <= 0 || (size_t) n >= len) {
+      return false;
+    }
+    dst.resize(n);
+    return true;
+  }
+#endif
+  default:
+    return false;
+  }
+}
+
+// Decompress a data block into a buffer of known size
+inline void octcol_decompress(int codec, const char *src, size_t len, char *dst, size_t dstlen) {
+  switch (codec) {
+  case OCTCOL_NONE:
+    if (len != dstlen) {
+      throw octcol_error("data block has inconsistent size");
+    }
+    std::copy(src, src + len, dst);
+    return;
+#ifdef HAVE_ZSTD
+  case OCTCOL_ZSTD: {
+    size_t n = ZSTD_decompress(dst, dstlen, src, len);
+    if (ZSTD_isError(n) || n != dstlen) {
+      throw octcol_error("could not decompress 'zstd' data block");
+    }
+    return;
+  }
+#endif
+#ifdef HAVE_LZ4
+  case OCTCOL_LZ4: {
+    int n = LZ4_decompress_safe(src, dst, (int) len, (int) dstlen);
+    if (n < 0 || (size_t) n != dstlen) {
+      throw octcol_error("could not decompress 'lz4' data block");
+    }
+    return;
+  }
+#endif
+  default:
+    throw octcol_error("data block uses codec '" + octcol_codec_name(codec) + "', which is not available in this build of OctApps");
+  }
+}
+
+// Append a value to a byte buffer
+template<typename T> inline void octcol_put(std::string& buf, const T& x) {
+  buf.append(reinterpret_cast<const char*>(&x), sizeof(T));
+}
+inline void octcol_put_string(std::string& buf, const std::string& s) {
+  octcol_put<uint16_t>(buf, (uint16_t) s.length());
+  buf.append(s);
+}
+inline void octcol_put_dims(std::string& buf, const std::vector<uint64_t>& dims) {
+  octcol_put<uint8_t>(buf, (uint8_t) dims.size());
+  for (size_t i = 0; i < dims.size(); ++i) {
+    octcol_put<uint64_t>(buf, dims[i]);
+  }
+}
+
+// Read values from a byte buffer
+class octcol_cursor {
+public:
+  const std::string& buf;
+  size_t pos;
+  octcol_cursor(const std::string& buf0) : buf(buf0), pos(0) { }
+  void need(size_t n) {
+    if (pos + n > buf.size()) {
+      throw octcol_error("index is truncated");
+    }
+  }
+  template<typename T> T get() {
+    need(sizeof(T));
+    T x;
+    std::copy(buf.data() + pos, buf.data() + pos + sizeof(T), reinterpret_cast<char*>(&x));
+    pos += sizeof(T);
+    return x;
+  }
+  std::string get_string() {
+    size_t n = get<uint16_t>();
+    need(n);
+    std::string s = buf.substr(pos, n);
+    pos += n;
+    return s;
+  }
+  std::vector<uint64_t> get_dims() {
+    size_t n = get<uint8_t>();
+    std::vector<uint64_t> dims(n);
+    for (size_t i = 0; i < n; ++i) {
+      dims[i] = get<uint64_t>();
+    }
+    return dims;
+  }
+};
+
+// Size of the fixed header: magic, byte-order mark, version, number of entries, index size
+#define OCTCOL_HEADER_SIZE (8 + 4 + 4 + 8 + 8)
+
+// Serialises Octave values into an OctCol index and data blocks
+class octcol_writer {
+public:
+
+  int codec;
+
+  uint64_t nentries;
+
+  std::string index;
+
+  std::vector<std::string> blocks;
+
+  uint64_t data_size;
+
+  octcol_writer(int codec0)
+    : codec(codec0), nentries(0), data_size(0)
+  { }
+
+  static std::vector<uint64_t> get_dims(const dim_vector& dv) {
+    std::vector<uint64_t> dims(dv.ndims());
+    for (size_t i = 0; i < dims.size(); ++i) {
+      dims[i] = dv(i);
+    }
+    return dims;
+  }
+
+  // Add a typed array entry, and its data block
+  void add_array(const std::string& name, int type, const dim_vector& dv, const void *data) {
+    const size_t raw = octcol_type_size(type) * dv.numel();
+    const char *src = reinterpret_cast<const char*>(data);
+    std::string block;
+    uint8_t block_codec = OCTCOL_NONE;
+    if (octcol_compress(codec, src, raw, block)) {
+      block_codec = codec;
+    } else {
+      block.assign(src, raw);
+    }
+    octcol_put<uint8_t>(index, OCTCOL_ARRAY);
+    octcol_put_string(index, name);
+    octcol_put<uint8_t>(index, type);
+    octcol_put<uint8_t>(index, block_codec);
+    octcol_put_dims(index, get_dims(dv));
+    octcol_put<uint64_t>(index, data_size);
+    octcol_put<uint64_t>(index, block.size());
+    octcol_put<uint64_t>(index, raw);
+    ++nentries;
+    data_size += block.size();
+    blocks.push_back(block);
+  }
+
+  // Add a struct or object entry; each field is stored as a cell array entry
+  void add_map(const std::string& name, const octave_map& m, const std::string& class_name, size_t depth = 0) {
+    if (depth > OCTCOL_MAX_DEPTH) {
+      throw octcol_error("values are nested too deeply");
+    }
+    string_vector keys = m.keys();
+    if (class_name.empty()) {
+      octcol_put<uint8_t>(index, OCTCOL_STRUCT);
+      octcol_put_string(index, name);
+    } else {
+      octcol_put<uint8_t>(index, OCTCOL_OBJECT);
+      octcol_put_string(index, name);
+      octcol_put_string(index, class_name);
+    }
+    octcol_put_dims(index, get_dims(m.dims()));
+    octcol_put<uint32_t>(index, keys.numel());
+    ++nentries;
+    for (octave_idx_type i = 0; i < keys.numel(); ++i) {
+      add_cell(keys(i), m.contents(keys(i)), depth + 1);
+    }
+  }
+
+  // Add a cell array entry, followed by entries for each element
+  void add_cell(const std::string& name, const Cell& c, size_t depth = 0) {
+    if (depth > OCTCOL_MAX_DEPTH) {
+      throw octcol_error("values are nested too deeply");
+    }
+    octcol_put<uint8_t>(index, OCTCOL_CELL);
+    octcol_put_string(index, name);
+    octcol_put_dims(index, get_dims(c.dims()));
+    ++nentries;
+    for (octave_idx_type i = 0; i < c.numel(); ++i) {
+      add("", c(i), depth + 1);
+    }
+  }
+
+  // Add an entry for any supported Octave value
+  void add(const std::string& name, const octave_value& v, size_t depth = 0) {
+    if (depth > OCTCOL_MAX_DEPTH) {
+      throw octcol_error("values are nested too deeply");
+    }
+    const dim_vector dv = v.dims();
+    if (v.is_sparse_type()) {
+      throw octcol_error("sparse matrices are not supported");
+    } else if (v.is_object()) {
+      add_map(name, v.map_value(), v.class_name(), depth);
+    } else if (v.is_map()) {
+      add_map(name, v.map_value(), "", depth);
+    } else if (v.is_cell()) {
+      add_cell(name, v.cell_value(), depth);
+    } else if (v.is_string()) {
+      charNDArray a = v.char_array_value();
+      add_array(name, v.is_dq_string() ? OCTCOL_CHAR_DQ : OCTCOL_CHAR_SQ, dv, a.data());
+    } else if (v.is_bool_type()) {
+      boolNDArray a = v.bool_array_value();
+      add_array(name, OCTCOL_LOGICAL, dv, a.data());
+    } else if (v.is_double_type() && v.is_complex_type()) {
+      ComplexNDArray a = v.complex_array_value();
+      add_array(name, OCTCOL_COMPLEX, dv, a.data());
+    } else if (v.is_double_type()) {
+      NDArray a = v.array_value();
+      add_array(name, OCTCOL_DOUBLE, dv, a.data());
+    } else if (v.is_single_type() && v.is_complex_type()) {
+      FloatComplexNDArray a = v.float_complex_array_value();
+      add_array(name, OCTCOL_FLOAT_COMPLEX, dv, a.data());
+    } else if (v.is_single_type()) {
+      FloatNDArray a = v.float_array_value();
+      add_array(name, OCTCOL_SINGLE, dv, a.data());
+    } else if (v.is_int8_type()) {
+      int8NDArray a = v.int8_array_value();
+      add_array(name, OCTCOL_INT8, dv, a.data());
+    } else if (v.is_int16_type()) {
+      int16NDArray a = v.int16_array_value();
+      add_array(name, OCTCOL_INT16, dv, a.data());
+    } else if (v.is_int32_type()) {
+      int32NDArray a = v.int32_array_value();
+      add_array(name, OCTCOL_INT32, dv, a.data());
+    } else if (v.is_int64_type()) {
+      int64NDArray a = v.int64_array_value();
+      add_array(name, OCTCOL_INT64, dv, a.data());
+    } else if (v.is_uint8_type()) {
+      uint8NDArray a = v.uint8_array_value();
+      add_array(name, OCTCOL_UINT8, dv, a.data());
+    } else if (v.is_uint16_type()) {
+      uint16NDArray a = v.uint16_array_value();
+      add_array(name, OCTCOL_UINT16, dv, a.data());
+    } else if (v.is_uint32_type()) {
+      uint32NDArray a = v.uint32_array_value();
+      add_array(name, OCTCOL_UINT32, dv, a.data());
+    } else if (v.is_uint64_type()) {
+      uint64NDArray a = v.uint64_array_value();
+      add_array(name, OCTCOL_UINT64, dv, a.data());
+    } else {
+      throw octcol_error("values of class '" + v.class_name() + "' are not supported");
+    }
+  }
+
+  // Write header, index, and data blocks to a file; the file is written under
+  // a temporary name and then renamed, so that readers (e.g. other jobs sharing
+  // the same directory) never see a partly-written file
+  void write(const std::string& filename) {
+    std::string tmpname = filename + ".XXXXXX";
+    int fd = mkstemp(&tmpname[0]);
+    if (fd < 0) {
+      throw octcol_error("could not open file for writing");
+    }
+    const mode_t mask = umask(0);
+    umask(mask);
+    fchmod(fd, 0666 & ~mask);
+    FILE *f = fdopen(fd, "wb");
+    if (f == 0) {
+      close(fd);
+      unlink(tmpname.c_str());
+      throw octcol_error("could not open file for writing");
+    }
+    std::string header(OCTCOL_MAGIC);
+    octcol_put<uint32_t>(header, OCTCOL_BOM);
+    octcol_put<uint32_t>(header, OCTCOL_VERSION);
+    octcol_put<uint64_t>(header, nentries);
+    octcol_put<uint64_t>(header, index.size());
+    bool ok = (header.size() == OCTCOL_HEADER_SIZE);
+    ok = ok && fwrite(header.data(), 1, header.size(), f) == header.size();
+    ok = ok && fwrite(index.data(), 1, index.size(), f) == index.size();
+    for (size_t i = 0; ok && i < blocks.size(); ++i) {
+      ok = fwrite(blocks[i].data(), 1, blocks[i].size(), f) == blocks[i].size();
+    }
+    ok = ok && fflush(f) == 0 && fsync(fileno(f)) == 0;
+    ok = (fclose(f) == 0) && ok;
+    ok = ok && rename(tmpname.c_str(), filename.c_str()) == 0;
+    if (!ok) {
+      unlink(tmpname.c_str());
+      throw octcol_error("could not write to file");
+    }
+  }
+
+  // Total size of the file written by write()
+  uint64_t file_size() const {
+    return OCTCOL_HEADER_SIZE + index.size() + data_size;
+  }
+
+};
+
+
+// Entry in the index of an OctCol file
+struct octcol_entry {
+  int kind;
+  std::string name;
+  std::string class_name;
+  int type;
+  int codec;
+  std::vector<uint64_t> dims;
+  uint64_t offset;
+  uint64_t stored;
+  uint64_t raw;
+  std::vector<size_t> children;
+};
+
+// Node in a tree of selected values; 'all' selects everything below the node,
+// otherwise 'sub' maps '.field' or '{k}' keys to selected child nodes
+struct octcol_select {
+  bool all;
+  std::map<std::string, size_t> sub;
+  octcol_select() : all(false) { }
+};
+
+// Reads selected values from an OctCol file
+class octcol_reader {
+public:
+
+  int fd;
+
+  const char *map;
+
+  size_t map_size;
+
+  uint64_t data_start;
+
+  std::vector<octcol_entry> entries;
+
+  std::vector<octcol_select> selects;
+
+  octcol_reader()
+    : fd(-1), map(0), map_size(0), data_start(0), selects(1)
+  { }
+
+  ~octcol_reader() {
+    if (map != 0) {
+      munmap(const_cast<char*>(map), map_size);
+    }
+    if (fd >= 0) {
+      close(fd);
+    }
+  }
+
+  // Open and memory-map file, and read header and index; data blocks are
+  // then read directly from the mapping, so only the pages holding selected
+  // values are ever read from disk
+  void open(const std::string& filename) {
+    fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+      throw octcol_io_error("could not open file for reading");
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+      throw octcol_io_error("could not open file for reading");
+    }
+    if ((uint64_t) st.st_size < OCTCOL_HEADER_SIZE) {
+      throw octcol_error("not an OctCol file");
+    }
+    void *p = mmap(0, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED) {
+      throw octcol_io_error("could not map file into memory");
+    }
+    map = reinterpret_cast<const char*>(p);
+    map_size = st.st_size;
+    std::string header(map, OCTCOL_HEADER_SIZE);
+    if (header.compare(0, 8, OCTCOL_MAGIC) != 0) {
+      throw octcol_error("not an OctCol file");
+    }
+    octcol_cursor hc(header);
+    hc.pos = 8;
+    if (hc.get<uint32_t>() != OCTCOL_BOM) {
+      throw octcol_error("file was written on a machine with a different byte order");
+    }
+    if (hc.get<uint32_t>() != OCTCOL_VERSION) {
+      throw octcol_error("unsupported OctCol format version");
+    }
+    const uint64_t nentries = hc.get<uint64_t>();
+    const uint64_t index_size = hc.get<uint64_t>();
+    if (index_size > map_size - OCTCOL_HEADER_SIZE) {
+      throw octcol_error("index is truncated");
+    }
+    if (nentries == 0 || nentries > index_size) {
+      // every index entry takes at least one byte
+      throw octcol_error("index is corrupted");
+    }
+    std::string index(map + OCTCOL_HEADER_SIZE, index_size);
+    data_start = OCTCOL_HEADER_SIZE + index_size;
+    entries.reserve(nentries);
+    octcol_cursor ic(index);
+    if (parse(ic, 0) != 0 || entries[0].kind != OCTCOL_STRUCT || entries.size() != nentries) {
+      throw octcol_error("index is corrupted");
+    }
+  }
+
+  // Parse the index entry at the cursor, and all entries below it
+  size_t parse(octcol_cursor& c, size_t depth) {
+    if (depth > OCTCOL_MAX_DEPTH) {
+      throw octcol_error("index is nested too deeply");
+    }
+    const size_t i = entries.size();
+    entries.push_back(octcol_entry());
+    int kind = c.get<uint8_t>();
+    entries[i].kind = kind;
+    entries[i].name = c.get_string();
+    size_t nchildren = 0;
+    switch (kind) {
+    case OCTCOL_ARRAY:
+      entries[i].type = c.get<uint8_t>();
+      entries[i].codec = c.get<uint8_t>();
+      entries[i].dims = c.get_dims();
+      entries[i].offset = c.get<uint64_t>();
+      entries[i].stored = c.get<uint64_t>();
+      entries[i].raw = c.get<uint64_t>();
+      if (entries[i].raw != octcol_type_size(entries[i].type) * numel(entries[i].dims)) {
+        throw octcol_error("index is corrupted");
+      }
+      break;
+    case OCTCOL_CELL:
+      entries[i].dims = c.get_dims();
+      nchildren = numel(entries[i].dims);
+      break;
+    case OCTCOL_OBJECT:
+      entries[i].class_name = c.get_string();
+      // fall through
+    case OCTCOL_STRUCT:
+      entries[i].dims = c.get_dims();
+      nchildren = c.get<uint32_t>();
+      break;
+    default:
+      throw octcol_error("index is corrupted");
+    }
+    for (size_t j = 0; j < nchildren; ++j) {
+      const size_t k = parse(c, depth + 1);
+      if (kind != OCTCOL_CELL && (entries[k].kind != OCTCOL_CELL || entries[k].dims != entries[i].dims)) {
+        throw octcol_error("index is corrupted");
+      }
+      entries[i].children.push_back(k);
+    }
+    return i;
+  }
+
+  static uint64_t numel(const std::vector<uint64_t>& dims) {
+    uint64_t n = 1;
+    for (size_t i = 0; i < dims.size(); ++i) {
+      n *= dims[i];
+    }
+    return n;
+  }
+
+  static dim_vector make_dims(const std::vector<uint64_t>& dims) {
+    dim_vector dv(1, 1);
+    if (dims.size() > 2) {
+      dv.resize(dims.size());
+    }
+    for (size_t i = 0; i < dims.size(); ++i) {
+      dv(i) = dims[i];
+    }
+    return dv;
+  }
+
+  // Add a selector to the tree of selected values
+  void add_selector(const std::string& selector) {
+    const std::string path = "." + selector;
+    size_t s = 0, i = 0;
+    while (i < path.size()) {
+      std::string key;
+      if (path[i] == '.') {
+        size_t j = i + 1;
+        while (j < path.size() && (isalnum(path[j]) || path[j] == '_')) {
+          ++j;
+        }
+        if (j == i + 1) {
+          throw octcol_select_error("invalid selector '" + selector + "'");
+        }
+        key = path.substr(i, j - i);
+        i = j;
+      } else if (path[i] == '{') {
+        size_t j = i + 1;
+        while (j < path.size() && isdigit(path[j])) {
+          ++j;
+        }
+        if (j == i + 1 || j == path.size() || path[j] != '}') {
+          throw octcol_select_error("invalid selector '" + selector + "'");
+        }
+        key = "{" + std::to_string(std::strtoull(path.substr(i + 1, j - i - 1).c_str(), 0, 10)) + "}";
+        i = j + 1;
+      } else {
+        throw octcol_select_error("invalid selector '" + selector + "'");
+      }
+      if (selects[s].all) {
+        return;
+      }
+      std::map<std::string, size_t>::const_iterator p = selects[s].sub.find(key);
+      if (p == selects[s].sub.end()) {
+        const size_t t = selects.size();
+        selects.push_back(octcol_select());
+        selects[s].sub[key] = t;
+        s = t;
+      } else {
+        s = p->second;
+      }
+    }
+    selects[s].all = true;
+    selects[s].sub.clear();
+  }
+
+  // Check that a data block lies within the file, before allocating memory for it
+  void check_block(const octcol_entry& e) {
+    const uint64_t avail = map_size - data_start;
+    if (e.offset > avail || e.stored > avail - e.offset) {
+      throw octcol_error("data block is truncated");
+    }
+  }
+
+  // Read, and if needed decompress, a data block into a buffer
+  void read_block(const octcol_entry& e, char *dst) {
+    check_block(e);
+    octcol_decompress(e.codec, map + data_start + e.offset, e.stored, dst, e.raw);
+  }
+
+  template<class A> octave_value read_array(const octcol_entry& e) {
+    check_block(e);
+    A a(make_dims(e.dims));
+    read_block(e, reinterpret_cast<char*>(a.fortran_vec()));
+    return octave_value(a);
+  }
+
+  octave_value read_char_array(const octcol_entry& e, char type) {
+    check_block(e);
+    charNDArray a(make_dims(e.dims));
+    read_block(e, reinterpret_cast<char*>(a.fortran_vec()));
+    return octave_value(a, type);
+  }
+
+  // Decode the elements of a cell array entry, applying the same selection to each element
+  Cell decode_elements(size_t ei, const octcol_select *s) {
+    const octcol_entry& e = entries[ei];
+    Cell c(make_dims(e.dims));
+    for (size_t i = 0; i < e.children.size(); ++i) {
+      c(i) = decode(e.children[i], s);
+    }
+    return c;
+  }
+
+  // Decode an entry and the selected entries below it
+  octave_value decode(size_t ei, const octcol_select *s) {
+    const octcol_entry& e = entries[ei];
+    const bool all = (s == 0 || s->all);
+    switch (e.kind) {
+
+    case OCTCOL_ARRAY:
+      if (!all) {
+        throw octcol_select_error("cannot select parts of arrays");
+      }
+      switch (e.type) {
+      case OCTCOL_DOUBLE:
+        return read_array<NDArray>(e);
+      case OCTCOL_SINGLE:
+        return read_array<FloatNDArray>(e);
+      case OCTCOL_COMPLEX:
+        return read_array<ComplexNDArray>(e);
+      case OCTCOL_FLOAT_COMPLEX:
+        return read_array<FloatComplexNDArray>(e);
+      case OCTCOL_INT8:
+        return read_array<int8NDArray>(e);
+      case OCTCOL_INT16:
+        return read_array<int16NDArray>(e);
+      case OCTCOL_INT32:
+        return read_array<int32NDArray>(e);
+      case OCTCOL_INT64:
+        return read_array<int64NDArray>(e);
+      case OCTCOL_UINT8:
+        return read_array<uint8NDArray>(e);
+      case OCTCOL_UINT16:
+        return read_array<uint16NDArray>(e);
+      case OCTCOL_UINT32:
+        return read_array<uint32NDArray>(e);
+      case OCTCOL_UINT64:
+        return read_array<uint64NDArray>(e);
+      case OCTCOL_LOGICAL:
+        return read_array<boolNDArray>(e);
+      case OCTCOL_CHAR_SQ:
+        return read_char_array(e, '\'');
+      case OCTCOL_CHAR_DQ:
+        return read_char_array(e, '"');
+      default:
+        throw octcol_error("index is corrupted");
+      }
+
+    case OCTCOL_CELL: {
+      if (all) {
+        return octave_value(decode_elements(ei, 0));
+      }
+      Cell c(make_dims(e.dims));
+      for (std::map<std::string, size_t>::const_iterator p = s->sub.begin(); p != s->sub.end(); ++p) {
+        const uint64_t k = (p->first[0] == '{') ? std::strtoull(p->first.c_str() + 1, 0, 10) : 0;
+        if (k < 1 || k > e.children.size()) {
+          throw octcol_select_error("selector '" + p->first + "' does not index an element of a cell array");
+        }
+        c(k - 1) = decode(e.children[k - 1], &selects[p->second]);
+      }
+      return octave_value(c);
+    }
+
+    case OCTCOL_STRUCT:
+    case OCTCOL_OBJECT: {
+      octave_map m(make_dims(e.dims));
+      for (size_t i = 0; i < e.children.size(); ++i) {
+        const std::string& field = entries[e.children[i]].name;
+        if (all) {
+          m.setfield(field, decode_elements(e.children[i], 0));
+        } else {
+          std::map<std::string, size_t>::const_iterator p = s->sub.find("." + field);
+          if (p != s->sub.end()) {
+            m.setfield(field, decode_elements(e.children[i], &selects[p->second]));
+          }
+        }
+      }
+      if (!all) {
+        for (std::map<std::string, size_t>::const_iterator p = s->sub.begin(); p != s->sub.end(); ++p) {
+          if (p->first[0] != '.' || !m.isfield(p->first.substr(1))) {
+            throw octcol_select_error("selector '" + p->first + "' does not name a field of a struct");
+          }
+        }
+      }
+      if (e.kind == OCTCOL_OBJECT && all) {
+        octave_class *obj = new octave_class(m, e.class_name, std::list<std::string>());
+        octave_value v(obj);
+        obj->reconstruct_exemplar();
+        return v;
+      }
+      return octave_value(m);
+    }
+
+    default:
+      throw octcol_error("index is corrupted");
+    }
+  }
+
+};
+
+
+#endif // _OCTCOLFILE_HPP
@@ -0,0 +1,182 @@
+//
+// Copyright (C) 2026 Karl Wette
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with with program; see the file COPYING. If not, write to the
+// Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+// MA  02111-1307  USA
+//
+
+#include <string>
+#include <vector>
+
+#include <octave/oct.h>
+#if OCTAVE_VERSION_HEX >= 0x040200
+#include <octave/interpreter.h>
+#else
+#include <octave/toplev.h>
+#endif
+
+#include "octcolfile.hpp"
+
+static const char *const octcolread_usage = "-*- texinfo -*- \n\
+@deftypefn {Loadable Function} {@var{S} =} octcolread ( @var{filename} )\n\
+@deftypefnx{Loadable Function} {@var{S} =} octcolread ( @var{filename}, @var{selector}, @dots{} )\n\
+\n\
+Read a struct @var{S} from @var{filename}, which must have been written by \
+@command{octcolwrite()} in the OctApps column-block (\"OctCol\") format.\n\
+\n\
+If one or more @var{selector}s (strings, or cell arrays of strings) are given, \
+only the selected values are read from @var{filename}; no other data are read \
+from disk or decompressed. Each @var{selector} is a path of the form \
+@samp{@var{name}}, @samp{@var{name}@{@var{k}@}}, @samp{@var{name}.@var{field}}, \
+@samp{@var{name}@{@var{k}@}.@var{field}}, etc. Cell arrays in @var{S} which are \
+only partly selected keep their full size, with unselected elements left empty; \
+structs which are only partly selected contain only the selected fields, and \
+partly-selected class objects are returned as plain structs. Selectors which \
+do not match the contents of @var{filename} raise an error with identifier \
+@samp{octapps:octcolread:selector}.\n\
+\n\
+@heading Examples\n\
+\n\
+@example\n\
+S = octcolread(\"stdres.col\");                                # Read all data in \"stdres.col\"\n\
+S = octcolread(\"stdres.col\", \"cpu_time\", \"wall_time\");      # Read only the CPU and wall times\n\
+S = octcolread(\"stdres.col\", \"results@{2@}.h0\");               # Read only field \"h0\" of the 2nd result\n\
+@end example\n\
+\n\
+@end deftypefn";
+
+DEFUN_DLD( octcolread, args, nargout, octcolread_usage ) {
+
+  // Prevent octave from crashing ...
+#if OCTAVE_VERSION_HEX < 0x040400
+  octave_exit = ::_Exit;
+#endif
+
+  // Check input and output
+  if (args.length() < 1 || nargout > 1) {
+    error("incorrect number of input/output arguments");
+    print_usage();
+    return octave_value();
+  }
+  if (!args(0).is_string()) {
+    error("argument #1 is not a string");
+    return octave_value();
+  }
+  std::string filename = args(0).string_value();
+
+  // Get list of selectors
+  std::vector<std::string> selectors;
+  for (octave_idx_type i = 1; i < args.length(); ++i) {
+    if (args(i).is_string()) {
+      selectors.push_back(args(i).string_value());
+    } else if (args(i).is_cell()) {
+      Cell c = args(i).cell_value();
+      for (octave_idx_type j = 0; j < c.numel(); ++j) {
+        if (!c(j).is_string()) {
+          error("argument #%li is not a cell array of strings", (long) i+1);
+          return octave_value();
+        }
+        selectors.push_back(c(j).string_value());
+      }
+    } else {
+      error("argument #%li is not a string or cell array of strings", (long) i+1);
+      return octave_value();
+    }
+  }
+
+  // Read selected values from file
+  octave_value S;
+  try {
+    octcol_reader reader;
+    reader.open(filename);
+    if (selectors.empty()) {
+      reader.selects[0].all = true;
+    }
+    for (size_t i = 0; i < selectors.size(); ++i) {
+      reader.add_selector(selectors[i]);
+    }
+    S = reader.decode(0, &reader.selects[0]);
+  } catch (const octcol_select_error& e) {
+    error_with_id("octapps:octcolread:selector", "in OctCol file '%s': %s", filename.c_str(), e.what());
+    return octave_value();
+  } catch (const octcol_error& e) {
+    error("in OctCol file '%s': %s", filename.c_str(), e.what());
+    return octave_value();
+  } catch (const std::bad_alloc& e) {
+    error("in OctCol file '%s': index is corrupted", filename.c_str());
+    return octave_value();
+  }
+
+  return S;
+
+}
+
+/*
+
+%!test
+%!  filename = [tempname(tempdir), ".col"];
+%!  S = struct("cpu_time", 1.5, "wall_time", 2.5, "results", {{struct("h0", 1:100, "x", "abc"), magic(4)}});
+%!  octcolwrite(filename, S, "auto");
+%!  assert(isequal(octcolread(filename), S));
+%!  T = octcolread(filename, "cpu_time", {"wall_time"});
+%!  assert(isequal(T, struct("cpu_time", 1.5, "wall_time", 2.5)));
+%!  T = octcolread(filename, "results{1}.h0");
+%!  assert(isequal(T.results, {struct("h0", 1:100), []}));
+%!  T = octcolread(filename, "results{2}", "results");
+%!  assert(isequal(T.results, S.results));
+%!  unlink(filename);
+
+%!test
+%!  filename = [tempname(tempdir), ".col"];
+%!  hgrm = addDataToHist(Hist(1, {"lin", "dbin", 0.1}), rand(100, 1));
+%!  octcolwrite(filename, struct("results", {{hgrm}}));
+%!  T = octcolread(filename);
+%!  assert(isa(T.results{1}, "Hist"));
+%!  assert(histTotalCount(T.results{1}) == 100);
+%!  unlink(filename);
+
+%!error octcolread(tempname(tempdir))
+
+%!test
+%!  ## corrupt number of index entries in header
+%!  filename = [tempname(tempdir), ".col"];
+%!  octcolwrite(filename, struct("x", 1:10));
+%!  fid = fopen(filename, "r+");
+%!  fseek(fid, 16, SEEK_SET);
+%!  fwrite(fid, intmax("uint64"), "uint64");
+%!  fclose(fid);
+%!  fail("octcolread(filename)", "index is corrupted");
+%!  unlink(filename);
+
+%!test
+%!  filename = [tempname(tempdir), ".col"];
+%!  octcolwrite(filename, struct("results", {{1, 2}}));
+%!  try
+%!    octcolread(filename, "results{3}");
+%!    error("octcolread() did not fail");
+%!  catch err
+%!    assert(err.identifier, "octapps:octcolread:selector");
+%!  end_try_catch
+%!  unlink(filename);
+
+%!test
+%!  filename = [tempname(tempdir), ".col"];
+%!  x = 1;
+%!  for i = 1:300
+%!    x = {x};
+%!  endfor
+%!  fail('octcolwrite(filename, struct("x", {x}))', "nested too deeply");
+
+*/
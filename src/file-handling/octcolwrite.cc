@@ -0,0 +1,108 @@
+//
+// Copyright (C) 2026 Karl Wette
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with with program; see the file COPYING. If not, write to the
+// Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+// MA  02111-1307  USA
+//
+
+#include <string>
+#include <vector>
+
+#include <octave/oct.h>
+#if OCTAVE_VERSION_HEX >= 0x040200
+#include <octave/interpreter.h>
+#else
+#include <octave/toplev.h>
+#endif
+
+#include "octcolfile.hpp"
+
+static const char *const octcolwrite_usage = "-*- texinfo -*- \n\
+@deftypefn {Loadable Function} {} octcolwrite ( @var{filename}, @var{S} )\n\
+@deftypefnx{Loadable Function} {} octcolwrite ( @var{filename}, @var{S}, @var{codec} )\n\
+\n\
+Write the fields of the scalar struct @var{S} to @var{filename} in the OctApps \
+column-block (\"OctCol\") format, which can be read back using @command{octcolread()}.\n\
+\n\
+Numeric, logical, and character arrays are written as typed column blocks; \
+cell arrays, struct arrays, and old-style class objects are written as a tree of \
+such blocks. A small index at the start of the file records the location of every \
+block, so that selected values can be read without decoding the rest of the file.\n\
+\n\
+@var{codec} selects how blocks are compressed: \"none\" (default), \"zstd\", \"lz4\", \
+or \"auto\" (the best codec available in this build of OctApps).\n\
+\n\
+@end deftypefn";
+
+DEFUN_DLD( octcolwrite, args, nargout, octcolwrite_usage ) {
+
+  // Prevent octave from crashing ...
+#if OCTAVE_VERSION_HEX < 0x040400
+  octave_exit = ::_Exit;
+#endif
+
+  // Check input and output
+  if (args.length() < 2 || args.length() > 3 || nargout > 0) {
+    error("incorrect number of input/output arguments");
+    print_usage();
+    return octave_value();
+  }
+  if (!args(0).is_string()) {
+    error("argument #1 is not a string");
+    return octave_value();
+  }
+  std::string filename = args(0).string_value();
+  if (!args(1).is_map() || args(1).numel() != 1) {
+    error("argument #2 is not a scalar struct");
+    return octave_value();
+  }
+  std::string codec_name = "none";
+  if (args.length() > 2) {
+    if (!args(2).is_string()) {
+      error("argument #3 is not a string");
+      return octave_value();
+    }
+    codec_name = args(2).string_value();
+  }
+
+  // Serialise struct and write to file
+  try {
+    octcol_writer writer(octcol_codec_value(codec_name));
+    writer.add_map("", args(1).map_value(), "");
+    writer.write(filename);
+  } catch (const octcol_error& e) {
+    error("in OctCol file '%s': %s", filename.c_str(), e.what());
+    return octave_value();
+  }
+
+  return octave_value_list();
+
+}
+
+/*
+
+%!test
+%!  filename = [tempname(tempdir), ".col"];
+%!  S = struct("x", 1.5, "y", int32([1 2; 3 4]), "s", "hello", "c", {{1, true, single(3), [1+2i, 3]}}, "t", struct("a", {1, 2}));
+%!  octcolwrite(filename, S);
+%!  assert(isequal(octcolread(filename), S));
+%!  octcolwrite(filename, S, "auto");
+%!  assert(isequal(octcolread(filename), S));
+%!  unlink(filename);
+
+%!error octcolwrite(tempname(tempdir), struct("f", @sin))
+%!error octcolwrite(tempname(tempdir), struct("x", 1), "bzip2")
+
+*/
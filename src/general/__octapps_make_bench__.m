@@ -0,0 +1,180 @@
+## Copyright (C) 2026 Karl Wette
+##
+## This program is free software; you can redistribute it and/or modify
+## it under the terms of the GNU General Public License as published by
+## the Free Software Foundation; either version 3 of the License, or
+## (at your option) any later version.
+##
+## This program is distributed in the hope that it will be useful,
+## but WITHOUT ANY WARRANTY; without even the implied warranty of
+## MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+## GNU General Public License for more details.
+##
+## You should have received a copy of the GNU General Public License
+## along with Octave; see the file COPYING.  If not, see
+## <http://www.gnu.org/licenses/>.
+
+
+## -*- texinfo -*-
+## @deftypefn
+##
+## Helper function for OctApps @command{make bench}.
+##
+## Runs the benchmark cases returned by the functions @file{bench_*.m} in
+## @var{benchdir}, or only those named in the space-separated string @var{names}.
+## Each function returns a struct array with fields @var{params} (a struct of
+## workload parameters), @var{setup} (a function returning the benchmark input),
+## @var{run} (the function being timed, which is passed the input), and
+## @var{cleanup} (a function to remove the input, or empty).
+##
+## Each case is run once to warm up, then @var{reps} times; the median, 10th
+## and 90th percentiles, minimum and maximum wall and CPU times, and the peak
+## resident memory (Linux only; otherwise -1), are printed and written as JSON
+## to @var{outfile}.
+##
+## @end deftypefn
+
+function __octapps_make_bench__(benchdir, outfile, reps, names)
+  crash_dumps_octave_core(0);
+  more off;
+
+  ## check input
+  assert(isdir(benchdir), "benchmark directory '%s' does not exist", benchdir);
+  assert(ischar(outfile));
+  assert(isscalar(reps) && reps > 0 && mod(reps, 1) == 0);
+  addpath(benchdir, "-begin");
+
+  ## find benchmarks
+  if nargin < 4 || isempty(strtrim(names))
+    files = dir(fullfile(benchdir, "bench_*.m"));
+    names = regexprep({files.name}, '^bench_(.*)\.m$', '$1');
+  else
+    names = regexprep(strsplit(strtrim(names), " "), '^bench_', '');
+    names = names(!cellfun(@isempty, names));
+  endif
+  for i = 1:numel(names)
+    assert(exist(strcat("bench_", names{i})) == 2, "unknown benchmark '%s'", names{i});
+  endfor
+
+  ## run benchmarks
+  results = struct("bench", {}, "params", {}, "reps", {}, "wall_s", {}, "cpu_s", {}, "peak_rss_bytes", {}, "peak_rss_delta_bytes", {});
+  printf("%-32s %-40s %12s %12s %12s %12s\n", "benchmark", "parameters", "wall/s", "wall p90/s", "cpu/s", "peak dRSS/MB");
+  for i = 1:numel(names)
+    cases = feval(strcat("bench_", names{i}));
+    if isempty(cases)
+      printf("%-32s %-40s\n", names{i}, "skipped: not available");
+      continue
+    endif
+    for j = 1:numel(cases)
+      c = cases(j);
+
+      ## create input with reproducible random numbers, then warm up
+      rand("state", 0);
+      randn("state", 0);
+      data = c.setup();
+      c.run(data);
+
+      ## time repeated runs, recording the peak resident memory
+      wall = cpu = zeros(reps, 1);
+      rss0 = reset_peak_rss();
+      for r = 1:reps
+        t0 = tic();
+        c0 = cputime();
+        c.run(data);
+        cpu(r) = cputime() - c0;
+        wall(r) = double(toc(t0));
+      endfor
+      rss = read_peak_rss();
+      if !isempty(c.cleanup)
+        c.cleanup(data);
+      endif
+      clear data;
+
+      ## record results
+      k = numel(results) + 1;
+      results(k).bench = names{i};
+      results(k).params = c.params;
+      results(k).reps = reps;
+      results(k).wall_s = time_stats(wall);
+      results(k).cpu_s = time_stats(cpu);
+      results(k).peak_rss_bytes = rss;
+      if rss0 >= 0 && rss >= 0
+        results(k).peak_rss_delta_bytes = rss - rss0;
+      else
+        results(k).peak_rss_delta_bytes = -1;
+      endif
+      printf("%-32s %-40s %12.4g %12.4g %12.4g %12.4g\n", names{i}, params_str(c.params),
+             results(k).wall_s.median, results(k).wall_s.p90, results(k).cpu_s.median,
+             results(k).peak_rss_delta_bytes / 2^20);
+
+    endfor
+  endfor
+
+  ## write results as JSON
+  meta = struct("octave_version", OCTAVE_VERSION, "octapps_commit", git_commit(benchdir),
+                "host", gethostname(), "date", datestr(now(), 31), "reps", reps);
+  resultsjson = cellfun(@object2json, num2cell(results), "UniformOutput", false);
+  json = sprintf('{"meta":%s,"results":[%s]}\n', object2json(meta), strjoin(resultsjson, ","));
+  fid = fopen(outfile, "w");
+  assert(fid >= 0, "could not open '%s'", outfile);
+  fputs(fid, json);
+  fclose(fid);
+  printf("Wrote benchmark results to '%s'\n", outfile);
+
+endfunction
+
+## summary statistics of timings
+function s = time_stats(t)
+  q = quantile(t(:), [0.1; 0.9]);
+  s = struct("median", median(t), "p10", q(1), "p90", q(2), "min", min(t), "max", max(t));
+endfunction
+
+## print parameters as 'name=value' pairs
+function str = params_str(params)
+  str = "";
+  for [v, n] = params
+    if ischar(v)
+      str = [str, sprintf("%s=%s ", n, v)];
+    else
+      str = [str, sprintf("%s=%g ", n, v)];
+    endif
+  endfor
+  str = strtrim(str);
+endfunction
+
+## reset the peak resident memory of this process (Linux only),
+## and return the current resident memory in bytes, or -1 if unavailable
+function rss = reset_peak_rss()
+  fid = fopen("/proc/self/clear_refs", "w");
+  if fid >= 0
+    fputs(fid, "5");
+    fclose(fid);
+  endif
+  rss = read_proc_status("VmRSS");
+endfunction
+
+## return the peak resident memory of this process in bytes, or -1 if unavailable
+function rss = read_peak_rss()
+  rss = read_proc_status("VmHWM");
+endfunction
+
+## read a memory size in bytes from /proc/self/status, or -1 if unavailable
+function bytes = read_proc_status(field)
+  bytes = -1;
+  if exist("/proc/self/status", "file")
+    tok = regexp(fileread("/proc/self/status"), [field, ':\s*(\d+)\s*kB'], "tokens", "once");
+    if !isempty(tok)
+      bytes = 1024 * str2double(tok{1});
+    endif
+  endif
+endfunction
+
+## return the git commit of the OctApps source tree, or "unknown" if unavailable
+function commit = git_commit(dir)
+  [status, commit] = system(sprintf("git -C '%s' rev-parse --short HEAD 2>/dev/null", dir));
+  if status == 0
+    commit = strtrim(commit);
+  else
+    commit = "unknown";
+  endif
+endfunction
@@ -0,0 +1,565 @@
+//
+// Copyright (C) 2026 Karl Wette
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with with program; see the file COPYING. If not, write to the
+// Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+// MA  02111-1307  USA
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include <octave/oct.h>
+#include <octave/pager.h>
+#if OCTAVE_VERSION_HEX >= 0x040200
+#include <octave/interpreter.h>
+#else
+#include <octave/toplev.h>
+#endif
+#if OCTAVE_VERSION_HEX < 0x060000
+#include <octave/variables.h>
+#endif
+
+#if OCTAVE_VERSION_HEX <= 0x030204
+#define octave_map Octave_map
+#endif
+
+#include "octapps_prof.hpp"
+
+static const char *const octapps_prof_usage = "-*- texinfo -*- \n\
+@deftypefn {Loadable Function} {} octapps_prof ( \"enable\" )\n\
+@deftypefnx{Loadable Function} {} octapps_prof ( \"disable\" )\n\
+@deftypefnx{Loadable Function} {@var{tf} =} octapps_prof ( \"enabled\" )\n\
+@deftypefnx{Loadable Function} {} octapps_prof ( \"trace\", @var{tf} )\n\
+@deftypefnx{Loadable Function} {@var{h} =} octapps_prof ( \"handle\", @var{name} )\n\
+@deftypefnx{Loadable Function} {@var{h} =} octapps_prof ( \"begin\", @var{name} | @var{h} )\n\
+@deftypefnx{Loadable Function} {} octapps_prof ( \"end\", @var{name} | @var{h} )\n\
+@deftypefnx{Loadable Function} {} octapps_prof ( \"count\", @var{name} | @var{h}, @var{calls}, [ @var{bytes} ] )\n\
+@deftypefnx{Loadable Function} {@var{report} =} octapps_prof ( \"report\" )\n\
+@deftypefnx{Loadable Function} {} octapps_prof ( \"write_trace\", @var{filename} )\n\
+@deftypefnx{Loadable Function} {} octapps_prof ( \"reset\" )\n\
+@deftypefnx{Loadable Function} {} octapps_prof ( \"dump\" )\n\
+\n\
+Hierarchical profiling counters, shared by all OctApps functions and extension \
+modules in an Octave process.\n\
+\n\
+Profiling is done through named scopes, which may be nested: each scope records \
+the number of times it was entered (@var{calls}), the elapsed wall and CPU time \
+spent in it, and the number of @var{bytes} processed. Scopes with the same name \
+are accumulated separately for each enclosing scope, so the @code{report} gives \
+a breakdown of where time is spent. In Octave functions, scopes are most easily \
+created using @command{octapps_prof_scope()}; extension modules use the \
+interface in @file{octapps_prof.hpp}. Names may be replaced by integer handles \
+@var{h} returned by @code{handle} or @code{begin}, to avoid looking up names.\n\
+\n\
+@table @code\n\
+@item enable\n\
+@itemx disable\n\
+Enable or disable profiling; profiling is disabled by default, and while \
+disabled scopes are not recorded.\n\
+\n\
+@item enabled\n\
+Return whether profiling is enabled.\n\
+\n\
+@item trace\n\
+If @var{tf} is true, also record every scope as an event in a trace, which is \
+written by @code{write_trace}. At most 1000000 events are recorded.\n\
+\n\
+@item handle\n\
+Return the handle @var{h} for the scope @var{name}.\n\
+\n\
+@item begin\n\
+@itemx end\n\
+Enter or leave a scope. Leaving a scope also leaves any scopes nested inside it \
+which were not left.\n\
+\n\
+@item count\n\
+Add @var{calls} and @var{bytes} to the counters of the scope @var{name}, nested \
+in the current scope, without recording any time.\n\
+\n\
+@item report\n\
+Print a hierarchical report of all recorded scopes, or if @var{report} is requested, \
+return a struct array with fields @var{name}, @var{path} (names of the enclosing \
+scopes separated by @samp{/}), @var{depth}, @var{calls}, @var{wall}, @var{self_wall} \
+(wall time not spent in nested scopes), @var{cpu}, and @var{bytes}.\n\
+\n\
+@item write_trace\n\
+Write the recorded trace to @var{filename} in the Chrome trace event JSON format, \
+which may be viewed with e.g. @url{https://ui.perfetto.dev}.\n\
+\n\
+@item reset\n\
+Remove all recorded scopes and trace events.\n\
+\n\
+@item dump\n\
+Print the report and/or write the trace, as requested by the environment variable \
+@env{OCTAPPS_PROF}. If @env{OCTAPPS_PROF} is set when @command{octapps_prof()} \
+is first loaded, profiling is enabled; it may contain a comma-separated list of \
+@code{report}, to print the report, and/or @code{trace=@var{filename}}, to record \
+and write a trace. @command{octapps_prof_scope()} arranges for @code{dump} to be \
+called when Octave exits.\n\
+@end table\n\
+\n\
+@end deftypefn";
+
+// Recorded scope, nested inside a parent scope
+struct prof_node {
+  int handle;
+  int parent;
+  int depth;
+  std::vector<int> children;
+  double calls, wall, cpu, bytes;
+  prof_node(int handle0, int parent0, int depth0)
+    : handle(handle0), parent(parent0), depth(depth0), calls(0), wall(0), cpu(0), bytes(0)
+  { }
+};
+
+// Entered scope which has not yet been left
+struct prof_frame {
+  int node;
+  double wall0, cpu0;
+};
+
+// Trace event
+struct prof_event {
+  int handle;
+  int depth;
+  double ts, dur;
+};
+
+static const size_t max_events = 1000000;
+
+static std::vector<std::string> names;
+static std::map<std::string, int> name_handles;
+static std::vector<prof_node> nodes(1, prof_node(-1, -1, -1));
+static std::vector<prof_frame> frames;
+static std::vector<prof_event> events;
+static double dropped_events = 0;
+static bool tracing = false;
+static double wall_origin = -1;
+static bool env_read = false;
+static bool env_report = false;
+static std::string env_trace;
+
+static double wall_now() {
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + 1e-9 * t.tv_nsec;
+}
+
+static double cpu_now() {
+  struct timespec t;
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &t);
+  return t.tv_sec + 1e-9 * t.tv_nsec;
+}
+
+static int prof_handle(const char *name) {
+  std::map<std::string, int>::const_iterator p = name_handles.find(name);
+  if (p != name_handles.end()) {
+    return p->second;
+  }
+  const int h = names.size();
+  names.push_back(name);
+  name_handles[name] = h;
+  return h;
+}
+
+// Return the node for the scope with handle 'h' inside the current scope, creating it if needed
+static int prof_child(int h) {
+  const int parent = frames.empty() ? 0 : frames.back().node;
+  const std::vector<int>& children = nodes[parent].children;
+  for (size_t i = 0; i < children.size(); ++i) {
+    if (nodes[children[i]].handle == h) {
+      return children[i];
+    }
+  }
+  const int n = nodes.size();
+  nodes.push_back(prof_node(h, parent, nodes[parent].depth + 1));
+  nodes[parent].children.push_back(n);
+  return n;
+}
+
+static void prof_begin(int h) {
+  prof_frame f;
+  f.node = prof_child(h);
+  f.cpu0 = cpu_now();
+  f.wall0 = wall_now();
+  frames.push_back(f);
+}
+
+static void prof_end(int h) {
+
+  // Find the innermost entered scope with this handle
+  size_t i = frames.size();
+  while (i > 0 && nodes[frames[i - 1].node].handle != h) {
+    --i;
+  }
+  if (i == 0) {
+    return;
+  }
+
+  // Leave this scope, and any scopes nested inside it
+  const double wall = wall_now();
+  const double cpu = cpu_now();
+  while (frames.size() >= i) {
+    const prof_frame& f = frames.back();
+    prof_node& n = nodes[f.node];
+    n.calls += 1;
+    n.wall += wall - f.wall0;
+    n.cpu += cpu - f.cpu0;
+    if (tracing) {
+      if (events.size() < max_events) {
+        prof_event e;
+        e.handle = n.handle;
+        e.depth = n.depth;
+        e.ts = f.wall0;
+        e.dur = wall - f.wall0;
+        events.push_back(e);
+      } else {
+        dropped_events += 1;
+      }
+    }
+    frames.pop_back();
+  }
+
+}
+
+static void prof_count(int h, double calls, double bytes) {
+  prof_node& n = nodes[prof_child(h)];
+  n.calls += calls;
+  n.bytes += bytes;
+}
+
+static void prof_add_bytes(double bytes) {
+  nodes[frames.empty() ? 0 : frames.back().node].bytes += bytes;
+}
+
+extern "C" {
+  octapps_prof::api octapps_prof_api_v1 = {
+    octapps_prof::api_version, false, prof_handle, prof_begin, prof_end, prof_count, prof_add_bytes
+  };
+}
+
+// Return the full name of a node, including the names of its parents
+static std::string node_path(int n) {
+  std::string path = names[nodes[n].handle];
+  for (int p = nodes[n].parent; p > 0; p = nodes[p].parent) {
+    path = names[nodes[p].handle] + "/" + path;
+  }
+  return path;
+}
+
+// List nodes in depth-first order
+static void node_order(int n, std::vector<int>& order) {
+  if (n > 0) {
+    order.push_back(n);
+  }
+  for (size_t i = 0; i < nodes[n].children.size(); ++i) {
+    node_order(nodes[n].children[i], order);
+  }
+}
+
+// Wall time of a node not spent in its children
+static double node_self_wall(int n) {
+  double wall = nodes[n].wall;
+  for (size_t i = 0; i < nodes[n].children.size(); ++i) {
+    wall -= nodes[nodes[n].children[i]].wall;
+  }
+  return wall;
+}
+
+// Escape a string for JSON output
+static std::string json_string(const std::string& str) {
+  std::string json = "\"";
+  for (size_t i = 0; i < str.size(); ++i) {
+    const unsigned char c = str[i];
+    if (c == '"' || c == '\\') {
+      json += '\\';
+      json += c;
+    } else if (c < 0x20) {
+      char buf[8];
+      snprintf(buf, sizeof(buf), "\\u%04x", c);
+      json += buf;
+    } else {
+      json += c;
+    }
+  }
+  return json + "\"";
+}
+
+static void print_report(std::ostream& os) {
+  std::vector<int> order;
+  node_order(0, order);
+  char buf[256];
+  snprintf(buf, sizeof(buf), "%-48s %10s %12s %12s %12s %12s\n", "scope", "calls", "wall/s", "self wall/s", "cpu/s", "bytes");
+  os << buf;
+  for (size_t i = 0; i < order.size(); ++i) {
+    const prof_node& n = nodes[order[i]];
+    const std::string name = std::string(2 * n.depth, ' ') + names[n.handle];
+    snprintf(buf, sizeof(buf), "%-48s %10.0f %12.6f %12.6f %12.6f %12.6g\n", name.c_str(), n.calls, n.wall, node_self_wall(order[i]), n.cpu, n.bytes);
+    os << buf;
+  }
+}
+
+static bool write_trace(const std::string& filename) {
+  FILE *f = fopen(filename.c_str(), "w");
+  if (f == 0) {
+    return false;
+  }
+  const int pid = getpid();
+  fprintf(f, "{\"traceEvents\":[");
+  for (size_t i = 0; i < events.size(); ++i) {
+    const prof_event& e = events[i];
+    fprintf(f, "%s\n{\"name\":%s,\"cat\":\"octapps\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%i,\"tid\":1,\"args\":{\"depth\":%i}}",
+            i > 0 ? "," : "", json_string(names[e.handle]).c_str(), 1e6 * (e.ts - wall_origin), 1e6 * e.dur, pid, e.depth);
+  }
+  fprintf(f, "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"dropped_events\":%.0f}}\n", dropped_events);
+  return fclose(f) == 0;
+}
+
+static void reset() {
+  nodes.assign(1, prof_node(-1, -1, -1));
+  frames.clear();
+  events.clear();
+  dropped_events = 0;
+  wall_origin = wall_now();
+}
+
+// Get the handle for a scope from a name or handle argument
+static int arg_handle(const octave_value& arg) {
+  if (arg.is_string()) {
+    return prof_handle(arg.string_value().c_str());
+  }
+  const int h = arg.int_value();
+  if (h < 0 || h >= (int) names.size()) {
+    error("invalid profiling handle %i", h);
+    return -1;
+  }
+  return h;
+}
+
+#if OCTAVE_VERSION_HEX >= 0x040400
+DEFMETHOD_DLD( octapps_prof, interp, args, nargout, octapps_prof_usage ) {
+#else
+DEFUN_DLD( octapps_prof, args, nargout, octapps_prof_usage ) {
+#endif
+
+  // Prevent octave from crashing ...
+#if OCTAVE_VERSION_HEX < 0x040400
+  octave_exit = ::_Exit;
+#endif
+
+  // Check input and output
+  if (args.length() < 1 || !args(0).is_string() || nargout > 1) {
+    print_usage();
+    return octave_value();
+  }
+  const std::string cmd = args(0).string_value();
+
+  // Enable profiling if requested by the environment variable OCTAPPS_PROF
+  if (!env_read) {
+    env_read = true;
+    wall_origin = wall_now();
+    const char *env = getenv("OCTAPPS_PROF");
+    if (env != 0 && *env != '\0') {
+      std::stringstream ss(env);
+      std::string item;
+      while (std::getline(ss, item, ',')) {
+        if (item == "report") {
+          env_report = true;
+        } else if (item.compare(0, 6, "trace=") == 0 && item.size() > 6) {
+          env_trace = item.substr(6);
+          tracing = true;
+        }
+      }
+      octapps_prof_api_v1.enabled = true;
+    }
+  }
+
+  // Keep this module loaded while profiling is enabled, so that other modules may use it
+  if (octapps_prof_api_v1.enabled || cmd == "enable") {
+#if OCTAVE_VERSION_HEX >= 0x060000
+    interp.mlock();
+#else
+    mlock();
+#endif
+  }
+
+  if (cmd == "enable" || cmd == "disable") {
+    if (args.length() != 1) {
+      print_usage();
+      return octave_value();
+    }
+    octapps_prof_api_v1.enabled = (cmd == "enable");
+    return octave_value();
+  }
+
+  if (cmd == "enabled") {
+    if (args.length() != 1) {
+      print_usage();
+      return octave_value();
+    }
+    return octave_value(octapps_prof_api_v1.enabled);
+  }
+
+  if (cmd == "trace") {
+    if (args.length() != 2) {
+      print_usage();
+      return octave_value();
+    }
+    tracing = args(1).bool_value();
+    return octave_value();
+  }
+
+  if (cmd == "handle" || cmd == "begin" || cmd == "end" || cmd == "count") {
+    if (args.length() != (cmd == "count" ? 3 : 2) && !(cmd == "count" && args.length() == 4)) {
+      print_usage();
+      return octave_value();
+    }
+    const int h = arg_handle(args(1));
+    if (h < 0) {
+      return octave_value();
+    }
+    if (octapps_prof_api_v1.enabled || cmd == "end") {
+      if (cmd == "begin") {
+        prof_begin(h);
+      } else if (cmd == "end") {
+        prof_end(h);
+      } else if (cmd == "count") {
+        prof_count(h, args(2).double_value(), args.length() > 3 ? args(3).double_value() : 0);
+      }
+    }
+    if (cmd == "handle" || cmd == "begin") {
+      return octave_value(h);
+    }
+    return octave_value();
+  }
+
+  if (cmd == "report") {
+    if (args.length() != 1) {
+      print_usage();
+      return octave_value();
+    }
+    if (nargout == 0) {
+      print_report(octave_stdout);
+      return octave_value();
+    }
+    std::vector<int> order;
+    node_order(0, order);
+    const char *const fieldnames[] = {"name", "path", "depth", "calls", "wall", "self_wall", "cpu", "bytes"};
+    const size_t nfields = sizeof(fieldnames) / sizeof(fieldnames[0]);
+    std::vector<Cell> fields(nfields, Cell(order.size(), 1));
+    for (size_t i = 0; i < order.size(); ++i) {
+      const prof_node& n = nodes[order[i]];
+      fields[0](i) = octave_value(names[n.handle]);
+      fields[1](i) = octave_value(node_path(order[i]));
+      fields[2](i) = octave_value(n.depth);
+      fields[3](i) = octave_value(n.calls);
+      fields[4](i) = octave_value(n.wall);
+      fields[5](i) = octave_value(node_self_wall(order[i]));
+      fields[6](i) = octave_value(n.cpu);
+      fields[7](i) = octave_value(n.bytes);
+    }
+    octave_map report(dim_vector(order.size(), 1));
+    for (size_t j = 0; j < nfields; ++j) {
+      report.setfield(fieldnames[j], fields[j]);
+    }
+    return octave_value(report);
+  }
+
+  if (cmd == "write_trace") {
+    if (args.length() != 2 || !args(1).is_string()) {
+      print_usage();
+      return octave_value();
+    }
+    const std::string filename = args(1).string_value();
+    if (!write_trace(filename)) {
+      error("could not write trace to '%s'", filename.c_str());
+    }
+    return octave_value();
+  }
+
+  if (cmd == "reset") {
+    if (args.length() != 1) {
+      print_usage();
+      return octave_value();
+    }
+    reset();
+    return octave_value();
+  }
+
+  if (cmd == "dump") {
+    if (args.length() != 1) {
+      print_usage();
+      return octave_value();
+    }
+    if (env_report) {
+      print_report(octave_stdout);
+    }
+    if (!env_trace.empty() && !write_trace(env_trace)) {
+      error("could not write trace to '%s'", env_trace.c_str());
+    }
+    return octave_value();
+  }
+
+  error("unknown command '%s'", cmd.c_str());
+  return octave_value();
+
+}
+
+/*
+
+%!test
+%!  octapps_prof("reset");
+%!  octapps_prof("enable");
+%!  octapps_prof("trace", true);
+%!  h = octapps_prof("begin", "__test_outer");
+%!  for i = 1:3
+%!    octapps_prof("begin", "__test_inner");
+%!    octapps_prof("count", "__test_bytes", 2, 1024);
+%!    octapps_prof("end", "__test_inner");
+%!  endfor
+%!  octapps_prof("begin", "__test_unclosed");
+%!  octapps_prof("end", h);
+%!  octapps_prof("disable");
+%!  assert(!octapps_prof("enabled"));
+%!  r = octapps_prof("report");
+%!  assert({r.path}, {"__test_outer", "__test_outer/__test_inner", "__test_outer/__test_inner/__test_bytes", "__test_outer/__test_unclosed"});
+%!  assert([r.depth], [0, 1, 2, 1]);
+%!  assert([r.calls], [1, 3, 6, 1]);
+%!  assert(r(3).bytes, 3072);
+%!  assert(r(1).wall >= r(2).wall + r(4).wall);
+%!  assert(r(1).self_wall >= 0);
+%!  fname = strcat(tempname(tempdir), ".json");
+%!  octapps_prof("write_trace", fname);
+%!  json = fileread(fname);
+%!  delete(fname);
+%!  assert(numel(strfind(json, "\"ph\":\"X\"")), 5);
+%!  octapps_prof("trace", false);
+%!  octapps_prof("reset");
+%!  assert(isempty(octapps_prof("report")));
+
+%!test
+%!  octapps_prof("disable");
+%!  h = octapps_prof("begin", "__test_disabled");
+%!  octapps_prof("end", h);
+%!  assert(isempty(octapps_prof("report")) || !any(strcmp({octapps_prof("report").name}, "__test_disabled")));
+
+*/
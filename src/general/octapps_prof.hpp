@@ -0,0 +1,155 @@
+//
+// Copyright (C) 2026 Karl Wette
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with with program; see the file COPYING. If not, write to the
+// Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+// MA  02111-1307  USA
+//
+
+// Interface to the profiling counters of octapps_prof(), for use by other
+// OctApps extension modules. Profiling is done through named, nestable scopes:
+//
+//   octapps_prof::scope prof("fitsread");              // times fitsread()
+//   ...
+//   {
+//     octapps_prof::scope prof_hdu(prof, "fitsread:hdu");  // times one HDU, nested
+//     ...
+//     prof_hdu.bytes(n);                               // counts bytes read
+//   }
+//
+// The octapps_prof() module exports its functions through a table with a C
+// symbol name. The first scope created by a module calls octapps_prof() once,
+// which loads it (and enables profiling if requested by OCTAPPS_PROF), and then
+// finds the table by opening octapps_prof.oct with dlopen(), which does not
+// depend on how Octave loaded it, and keeps it open, so that the table remains
+// valid if Octave later unloads the module. After that, if the module is not
+// built, or profiling is disabled, scopes do nothing beyond testing a flag.
+// Scopes must only be used by the Octave thread.
+
+#ifndef _OCTAPPS_PROF_HPP
+#define _OCTAPPS_PROF_HPP
+
+#include <dlfcn.h>
+
+#include <string>
+
+#include <octave/parse.h>
+
+#define OCTAPPS_PROF_API_SYMBOL "octapps_prof_api_v1"
+
+namespace octapps_prof {
+
+  // Table of functions exported by octapps_prof()
+  struct api {
+    int version;
+    bool enabled;
+    int (*handle)(const char *name);
+    void (*begin)(int h);
+    void (*end)(int h);
+    void (*count)(int h, double calls, double bytes);
+    void (*add_bytes)(double bytes);
+  };
+
+  const int api_version = 1;
+
+  // Find the functions exported by octapps_prof(), or return NULL if the module is not built
+  inline const api *find_api() {
+    void *sym = 0;
+    try {
+#if OCTAVE_VERSION_HEX >= 0x040400
+      const octave_value_list r = octave::feval("file_in_loadpath", octave_value_list(octave_value("octapps_prof.oct")), 1);
+#else
+      const octave_value_list r = feval("file_in_loadpath", octave_value_list(octave_value("octapps_prof.oct")), 1);
+#endif
+      if (r.length() == 0 || !r(0).is_string()) {
+        return 0;
+      }
+      const std::string path = r(0).string_value();
+#if OCTAVE_VERSION_HEX >= 0x040400
+      octave::feval("octapps_prof", octave_value_list(octave_value("enabled")), 1);
+#else
+      feval("octapps_prof", octave_value_list(octave_value("enabled")), 1);
+#endif
+      void *lib = dlopen(path.c_str(), RTLD_LAZY);
+      if (lib != 0) {
+        sym = dlsym(lib, OCTAPPS_PROF_API_SYMBOL);
+      }
+    } catch (...) {
+      return 0;
+    }
+    const api *a = static_cast<const api*>(sym);
+    return (a != 0 && a->version == api_version) ? a : 0;
+  }
+
+  // Return the functions exported by octapps_prof(), or NULL if profiling is not available or disabled
+  inline const api *get_api() {
+    static const api *const a = find_api();
+    return (a != 0 && a->enabled) ? a : 0;
+  }
+
+  // Scoped timer which records the wall and CPU time between its construction
+  // and destruction, nested inside any enclosing scope
+  class scope {
+
+  private:
+    const api *a;
+    int h;
+
+    scope(const scope&);
+    scope& operator=(const scope&);
+
+    void begin(const char *name) {
+      if (a != 0) {
+        h = a->handle(name);
+        a->begin(h);
+      }
+    }
+
+  public:
+
+    // Start a top-level scope
+    explicit scope(const char *name) : a(get_api()), h(-1) {
+      begin(name);
+    }
+
+    // Start a scope nested within 'parent'
+    scope(const scope& parent, const char *name) : a(parent.a != 0 && parent.a->enabled ? parent.a : 0), h(-1) {
+      begin(name);
+    }
+
+    ~scope() {
+      if (a != 0) {
+        a->end(h);
+      }
+    }
+
+    // Add to the number of bytes processed within this scope
+    void bytes(double n) const {
+      if (a != 0) {
+        a->add_bytes(n);
+      }
+    }
+
+    // Add to the number of calls and bytes of a named counter within this scope
+    void count(const char *name, double calls, double n = 0) const {
+      if (a != 0) {
+        a->count(a->handle(name), calls, n);
+      }
+    }
+
+  };
+
+}
+
+#endif // _OCTAPPS_PROF_HPP
@@ -0,0 +1,72 @@
+## Copyright (C) 2026 Karl Wette
+##
+## This program is free software; you can redistribute it and/or modify
+## it under the terms of the GNU General Public License as published by
+## the Free Software Foundation; either version 3 of the License, or
+## (at your option) any later version.
+##
+## This program is distributed in the hope that it will be useful,
+## but WITHOUT ANY WARRANTY; without even the implied warranty of
+## MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+## GNU General Public License for more details.
+##
+## You should have received a copy of the GNU General Public License
+## along with Octave; see the file COPYING.  If not, see
+## <http://www.gnu.org/licenses/>.
+
+
+## -*- texinfo -*-
+## @deftypefn {Function File} {@var{scope} =} octapps_prof_scope ( @var{name} )
+##
+## Enter the profiling scope @var{name} (see @command{octapps_prof()}), and
+## return an object @var{scope} which leaves the scope when it is cleared,
+## e.g. when the calling function returns:
+##
+## @example
+## function y = f(x)
+##   prof = octapps_prof_scope(funcName);
+##   ...
+## endfunction
+## @end example
+##
+## If @command{octapps_prof()} is not available, or profiling is disabled,
+## @var{scope} is empty.
+##
+## @end deftypefn
+
+function scope = octapps_prof_scope(name)
+
+  ## check whether profiling is available; if profiling was enabled by the
+  ## environment variable OCTAPPS_PROF, print/write results at exit
+  persistent have_prof;
+  if isempty(have_prof)
+    have_prof = (exist("octapps_prof") == 3);
+    if have_prof && octapps_prof("enabled") && !isempty(getenv("OCTAPPS_PROF")) && exist("atexit") == 5
+      atexit("__octapps_prof_dump__");
+    endif
+  endif
+
+  ## enter scope, and leave it when 'scope' is cleared
+  if have_prof && octapps_prof("enabled")
+    h = octapps_prof("begin", name);
+    scope = onCleanup(@() octapps_prof("end", h));
+  else
+    scope = [];
+  endif
+
+endfunction
+
+%!test
+%!  if exist("octapps_prof") != 3
+%!    disp("skipping test: octapps_prof() not available"); return;
+%!  endif
+%!  octapps_prof("reset");
+%!  octapps_prof("enable");
+%!  prof = octapps_prof_scope("__test");
+%!  clear prof;
+%!  octapps_prof("disable");
+%!  assert(isempty(octapps_prof_scope("__test_disabled")));
+%!  r = octapps_prof("report");
+%!  octapps_prof("reset");
+%!  assert({r.name}, {"__test"});
+%!  assert(r.calls, 1);
@@ -61,6 +61,12 @@
 
 function hgrm = LatticeMismatchHist( dim, lattice, varargin )
 
+  ## whether octapps_cache() store has been configured
+  persistent cache_configured = false;
+
+  ## profile this function
+  prof = octapps_prof_scope(funcName);
+
   ## check input
   assert( isscalar( dim ) && dim > 0 );
   assert( ischar( lattice ) );
@@ -76,30 +82,51 @@ function hgrm = LatticeMismatchHist( dim, lattice, varargin )
   ## if using cache
   if use_cache
 
-    ## load mismatch histogram cache
-    lattice_cache = load(__depends_extra_files__());
+    ## look up mismatch histogram using octapps_cache(), if available;
+    ## otherwise load it from the mismatch histogram cache, and add it
+    ## to octapps_cache() (in memory only) for subsequent calls
+    have_cache = (exist("octapps_cache") == 3);
+    key = octapps_md5sum(stringify({dim, lattice}));
+    found = false;
+    if have_cache
+      if !cache_configured
+        octapps_cache("config", funcName, "disk", false);
+        cache_configured = true;
+      endif
+      [found, hgrm] = octapps_cache("get", funcName, key);
+    endif
+    if !found
+      hgrm = [];
+
+      ## load mismatch histogram cache
+      lattice_cache = load(__depends_extra_files__());
+
+      ## check if mismatch histogram is in cache
+      lattice_cache_field = sprintf("%s_lattice_mismatch_hgrms", lattice);
+      if isfield(lattice_cache, lattice_cache_field)
+        lattice_cache_hgrms = lattice_cache.(lattice_cache_field);
+        if dim <= length(lattice_cache_hgrms)
+          hgrm = lattice_cache_hgrms{dim};
+        endif
+      endif
+      if have_cache
+        octapps_cache("put", funcName, key, hgrm);
+      endif
 
-    ## check if mismatch histogram is in cache
-    lattice_cache_field = sprintf("%s_lattice_mismatch_hgrms", lattice);
-    if isfield(lattice_cache, lattice_cache_field)
-      lattice_cache_hgrms = lattice_cache.(lattice_cache_field);
-      if dim <= length(lattice_cache_hgrms)
-        hgrm = lattice_cache_hgrms{dim};
+    endif
 
-        ## check that cached histogram has sufficient resolution
-        if N <= histTotalCount(hgrm)
+    ## check that cached histogram has sufficient resolution
+    if !isempty(hgrm) && N <= histTotalCount(hgrm)
 
-          ## rescale histogram to desired maximum mismatch
-          hgrm = rescaleHistBins(hgrm, mu_max);
+      ## rescale histogram to desired maximum mismatch
+      hgrm = rescaleHistBins(hgrm, mu_max);
 
-          ## resample histogram to desired bin size
-          hgrm = resampleHist(hgrm, 1, unique([0.0:dbin:mu_max, mu_max]));
+      ## resample histogram to desired bin size
+      hgrm = resampleHist(hgrm, 1, unique([0.0:dbin:mu_max, mu_max]));
 
-          ## return cached histogram
-          return
+      ## return cached histogram
+      return
 
-        endif
-      endif
     endif
 
   endif
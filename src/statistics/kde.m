@@ -76,6 +76,9 @@
 ##
 ## @end table
 ##
+## If available, the compiled function @command{kdebatch()} is used to
+## compute the estimate; it can also compute estimates of many datasets at once.
+##
 ## @heading Reference
 ## Please cite in your work:
 ## @indentedblock
@@ -107,6 +110,15 @@ function [bandwidth,density,xmesh]=kde(data,n,MIN,MAX)
     Range=maximum-minimum;
     MIN=minimum-Range/10; MAX=maximum+Range/10;
   end
+  ## use compiled implementation, if available
+  if exist("kdebatch") == 3
+    [bandwidth,density,xmesh]=kdebatch(data,n,MIN,MAX,1);
+    xmesh=xmesh';
+    if nargout==0
+      figure(1), plot(xmesh,density)
+    end
+    return
+  end
   ## set up the grid over which the density estimate is computed;
   R=MAX-MIN; dx=R/(n-1); xmesh=MIN+[0:dx:R]; N=length(data);
   ## bin the data uniformly using the grid define above;
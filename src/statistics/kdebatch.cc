@@ -0,0 +1,476 @@
+//
+// Copyright (C) 2026 Karl Wette
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with with program; see the file COPYING. If not, write to the
+// Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+// MA  02111-1307  USA
+//
+
+#include <cfloat>
+#include <cmath>
+#include <algorithm>
+#include <map>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fftw3.h>
+
+#include <octave/oct.h>
+#if OCTAVE_VERSION_HEX >= 0x040200
+#include <octave/interpreter.h>
+#else
+#include <octave/toplev.h>
+#endif
+#include <octave/Cell.h>
+
+static const char *const kdebatch_usage = "-*- texinfo -*- \n\
+@deftypefn {Loadable Function} { [ @var{bandwidth}, @var{density}, @var{xmesh} ] =} kdebatch ( @var{data} )\n\
+@deftypefnx{Loadable Function} { [ @dots{} ] =} kdebatch ( @var{data}, @var{n}, @var{MIN}, @var{MAX} )\n\
+@deftypefnx{Loadable Function} { [ @dots{} ] =} kdebatch ( @var{data}, @var{n}, @var{MIN}, @var{MAX}, @var{num_threads} )\n\
+\n\
+Compute kernel density estimates of many one-dimensional datasets at once, \
+using the same method as @command{kde()}.\n\
+\n\
+@var{data} is either a matrix, whose columns are the datasets, or a cell array \
+of vectors. @var{n} is the number of mesh points, rounded up to the next power \
+of two [default: 2^14]. @var{MIN} and @var{MAX} define the interval on which \
+each density estimate is constructed, and are either scalars or vectors with \
+one element per dataset; if empty or not given, they default to the range of \
+each dataset extended by a tenth at either end.\n\
+\n\
+Returns a row vector @var{bandwidth}, and @var{n}-by-K matrices @var{density} \
+and @var{xmesh}, with one column for each of the K datasets.\n\
+\n\
+The discrete cosine transforms are computed using FFTW plans which are cached \
+between calls, and datasets are processed using @var{num_threads} threads \
+[default: number of processors].\n\
+\n\
+@end deftypefn";
+
+// Cached FFTW plans for forward (DCT-II) and inverse (DCT-III) transforms
+// of a given length; plans are created with FFTW-allocated arrays, and so
+// may be executed on any other FFTW-allocated arrays from any thread
+struct dct_plans {
+  fftw_plan fwd, inv;
+};
+
+static const dct_plans& get_dct_plans(int n) {
+  static std::map<int, dct_plans> cache;
+  std::map<int, dct_plans>::const_iterator p = cache.find(n);
+  if (p == cache.end()) {
+    double *in = (double*) fftw_malloc(n * sizeof(double));
+    double *out = (double*) fftw_malloc(n * sizeof(double));
+    dct_plans plans;
+    plans.fwd = fftw_plan_r2r_1d(n, in, out, FFTW_REDFT10, FFTW_MEASURE);
+    plans.inv = fftw_plan_r2r_1d(n, in, out, FFTW_REDFT01, FFTW_MEASURE);
+    fftw_free(in);
+    fftw_free(out);
+    p = cache.insert(std::make_pair(n, plans)).first;
+  }
+  return p->second;
+}
+
+// Density estimate of a single dataset
+struct kde_result {
+  double bandwidth;
+  std::vector<double> density;
+  bool ok;
+};
+
+// Evaluate the function t - zeta * gamma^[l](t), whose root is the optimal squared bandwidth;
+// Ia2[s][k-1] = k^(2*s) * (a_k / 2)^2 are precomputed for s = 2..7
+static double fixed_point(const double t, const double N, const std::vector<double> Ia2[8]) {
+  const int l = 7;
+  const size_t m = Ia2[l].size();
+
+  // Sum of Ia2[s][k-1] * exp(-k^2 * pi^2 * time) over k; the exponentials are
+  // computed by recurrence, exp(-k^2 x) = exp(-(k-1)^2 x) * exp(-(2k-1) x),
+  // resynchronised every so often to limit the accumulation of round-off error,
+  // and summed until they underflow
+  const double pi2 = M_PI * M_PI;
+  auto sum_exp = [m, pi2](const std::vector<double>& Ia2s, const double time) {
+    const double x = pi2 * time;
+    const double q2 = std::exp(-2 * x);
+    double sum = 0, r = std::exp(-x), e = r;
+    for (size_t k = 1; k <= m; ++k) {
+      if (k % 64 == 0) {
+        e = std::exp(-((double) k) * k * x);
+        r = std::exp(-(2.0 * k - 1) * x);
+      } else if (k > 1) {
+        r *= q2;
+        e *= r;
+      }
+      if (e < DBL_MIN) {
+        break;
+      }
+      sum += Ia2s[k - 1] * e;
+    }
+    return sum;
+  };
+
+  double f = 2 * std::pow(M_PI, 2 * l) * sum_exp(Ia2[l], t);
+  for (int s = l - 1; s >= 2; --s) {
+    double K0 = 1;
+    for (int j = 1; j <= 2 * s - 1; j += 2) {
+      K0 *= j;
+    }
+    K0 /= std::sqrt(2 * M_PI);
+    const double c = (1 + std::pow(0.5, s + 0.5)) / 3;
+    const double time = std::pow(2 * c * K0 / N / f, 2.0 / (3 + 2 * s));
+    f = 2 * std::pow(M_PI, 2 * s) * sum_exp(Ia2[s], time);
+  }
+  return t - std::pow(2 * N * std::sqrt(M_PI) * f, -2.0 / 5);
+}
+
+// Find a root of f in [a, b] using Brent's method; returns false if [a, b] does not bracket a root
+template<class F> static bool find_root(F f, double a, double b, double& root) {
+  double fa = f(a), fb = f(b);
+  if (fa == 0) {
+    root = a;
+    return true;
+  }
+  if (fb == 0) {
+    root = b;
+    return true;
+  }
+  if (!(std::signbit(fa) != std::signbit(fb))) {
+    return false;
+  }
+  double c = a, fc = fa, d = b - a, e = d;
+  for (int iter = 0; iter < 200; ++iter) {
+    if (std::signbit(fb) == std::signbit(fc)) {
+      c = a;
+      fc = fa;
+      d = e = b - a;
+    }
+    if (std::fabs(fc) < std::fabs(fb)) {
+      a = b; b = c; c = a;
+      fa = fb; fb = fc; fc = fa;
+    }
+    const double tol = 2 * DBL_EPSILON * std::fabs(b);
+    const double m = 0.5 * (c - b);
+    if (std::fabs(m) <= tol || fb == 0) {
+      break;
+    }
+    if (std::fabs(e) < tol || std::fabs(fa) <= std::fabs(fb)) {
+      d = e = m;
+    } else {
+      double p, q, r, s = fb / fa;
+      if (a == c) {
+        p = 2 * m * s;
+        q = 1 - s;
+      } else {
+        q = fa / fc;
+        r = fb / fc;
+        p = s * (2 * m * q * (q - r) - (b - a) * (r - 1));
+        q = (q - 1) * (r - 1) * (s - 1);
+      }
+      if (p > 0) {
+        q = -q;
+      } else {
+        p = -p;
+      }
+      if (2 * p < std::min(3 * m * q - std::fabs(tol * q), std::fabs(e * q))) {
+        e = d;
+        d = p / q;
+      } else {
+        d = e = m;
+      }
+    }
+    a = b;
+    fa = fb;
+    b += (std::fabs(d) > tol) ? d : (m > 0 ? tol : -tol);
+    fb = f(b);
+  }
+  root = b;
+  return true;
+}
+
+// Compute the density estimate of a single dataset; only uses C++ data structures,
+// since the Octave API is not thread-safe
+static void kde_one(const double *data, const size_t N, const int n, const double MIN, const double MAX, const dct_plans& plans, double *buf_in, double *buf_out, kde_result& res) {
+  res.ok = false;
+
+  // Bin the data uniformly on the mesh, with the same conventions as histc()
+  const double R = MAX - MIN, dx = R / (n - 1);
+  std::fill(buf_in, buf_in + n, 0.0);
+  for (size_t i = 0; i < N; ++i) {
+    const double x = data[i];
+    if (!(MIN <= x && x <= MIN + (n - 1) * dx)) {
+      continue;
+    }
+    long k = std::min((long) n - 1, (long) std::floor((x - MIN) / dx));
+    while (k > 0 && x < MIN + k * dx) {
+      --k;
+    }
+    while (k < n - 1 && x >= MIN + (k + 1) * dx) {
+      ++k;
+    }
+    buf_in[k] += 1;
+  }
+  for (int k = 0; k < n; ++k) {
+    buf_in[k] /= N;
+  }
+
+  // Discrete cosine transform of binned data: a_0 = sum(x), a_k = 2 * sum(x_j * cos(pi * k * (2j+1) / 2n))
+  fftw_execute_r2r(plans.fwd, buf_in, buf_out);
+  std::vector<double> a(buf_out, buf_out + n);
+  a[0] *= 0.5;
+
+  // Precompute terms of the fixed-point function
+  std::vector<double> Ia2[8];
+  for (int s = 2; s <= 7; ++s) {
+    Ia2[s].resize(n - 1);
+    for (int k = 1; k < n; ++k) {
+      const double I = ((double) k) * k, a2 = 0.25 * a[k] * a[k];
+      Ia2[s][k - 1] = std::pow(I, s) * a2;
+    }
+  }
+
+  // Solve for the optimal squared bandwidth
+  double t_star = 0;
+  if (!find_root([N, &Ia2](double t) { return fixed_point(t, N, Ia2); }, 0, 0.1, t_star)) {
+    return;
+  }
+
+  // Smooth the transform, and apply the inverse transform
+  for (int k = 0; k < n; ++k) {
+    buf_in[k] = a[k] * std::exp(-((double) k) * k * M_PI * M_PI * t_star / 2);
+    if (k > 0) {
+      buf_in[k] *= 0.5;
+    }
+  }
+  fftw_execute_r2r(plans.inv, buf_in, buf_out);
+  res.density.assign(buf_out, buf_out + n);
+  for (int k = 0; k < n; ++k) {
+    res.density[k] /= R;
+  }
+
+  // Take the rescaling of the data into account
+  res.bandwidth = std::sqrt(t_star) * R;
+  res.ok = true;
+
+}
+
+DEFUN_DLD( kdebatch, args, nargout, kdebatch_usage ) {
+
+  // Prevent octave from crashing ...
+#if OCTAVE_VERSION_HEX < 0x040400
+  octave_exit = ::_Exit;
+#endif
+
+  // Check input and output
+  if (args.length() < 1 || args.length() > 5 || nargout > 3) {
+    print_usage();
+    return octave_value();
+  }
+
+  // Collect datasets
+  std::vector<std::vector<double> > data;
+  if (args(0).is_cell()) {
+    const Cell data_cell = args(0).cell_value();
+    for (octave_idx_type j = 0; j < data_cell.numel(); ++j) {
+      if (!data_cell(j).is_real_type()) {
+        error("argument #1 is not a real matrix or a cell array of real vectors");
+        return octave_value();
+      }
+      const NDArray v = data_cell(j).array_value();
+      data.push_back(std::vector<double>(v.data(), v.data() + v.numel()));
+    }
+  } else if (args(0).is_real_type()) {
+    const Matrix m = args(0).matrix_value();
+    const double *p = m.data();
+    for (octave_idx_type j = 0; j < m.columns(); ++j, p += m.rows()) {
+      data.push_back(std::vector<double>(p, p + m.rows()));
+    }
+  } else {
+    error("argument #1 is not a real matrix or a cell array of real vectors");
+    return octave_value();
+  }
+  const size_t K = data.size();
+  for (size_t j = 0; j < K; ++j) {
+    if (data[j].empty()) {
+      error("dataset #%i is empty", (int) j + 1);
+      return octave_value();
+    }
+  }
+
+  // Number of mesh points, rounded up to the next power of two
+  int n = 1 << 14;
+  if (args.length() > 1 && args(1).numel() > 0) {
+    if (!args(1).is_real_scalar() || args(1).double_value() < 2) {
+      error("argument #2 is not a real scalar >= 2");
+      return octave_value();
+    }
+    n = 1 << ((int) std::ceil(std::log2(args(1).double_value())));
+  }
+
+  // Interval on which density estimates are constructed
+  std::vector<double> MIN(K), MAX(K);
+  for (size_t j = 0; j < K; ++j) {
+    double minimum = lo_ieee_inf_value(), maximum = -lo_ieee_inf_value();
+    for (size_t i = 0; i < data[j].size(); ++i) {
+      minimum = std::min(minimum, data[j][i]);
+      maximum = std::max(maximum, data[j][i]);
+    }
+    const double Range = maximum - minimum;
+    MIN[j] = minimum - Range / 10;
+    MAX[j] = maximum + Range / 10;
+  }
+  for (int i = 2; i <= 3; ++i) {
+    if (args.length() > i && args(i).numel() > 0) {
+      const NDArray v = args(i).array_value();
+      if (v.numel() != 1 && (size_t) v.numel() != K) {
+        error("argument #%i must be a scalar or a vector with one element per dataset", i + 1);
+        return octave_value();
+      }
+      for (size_t j = 0; j < K; ++j) {
+        (i == 2 ? MIN : MAX)[j] = v(v.numel() == 1 ? 0 : j);
+      }
+    }
+  }
+  for (size_t j = 0; j < K; ++j) {
+    if (!(MIN[j] < MAX[j])) {
+      error("dataset #%i does not define a valid interval [MIN, MAX]", (int) j + 1);
+      return octave_value();
+    }
+  }
+
+  // Number of threads
+  size_t num_threads = std::max(1u, std::thread::hardware_concurrency());
+  if (args.length() > 4) {
+    if (!args(4).is_real_scalar() || args(4).double_value() < 1) {
+      error("argument #5 is not a strictly positive integer");
+      return octave_value();
+    }
+    num_threads = (size_t) args(4).double_value();
+  }
+  num_threads = std::max((size_t) 1, std::min(num_threads, K));
+
+  // Get cached plans; FFTW planning is not thread-safe, so must be done here
+  const dct_plans& plans = get_dct_plans(n);
+  if (plans.fwd == 0 || plans.inv == 0) {
+    error("could not create FFTW plans of length %i", n);
+    return octave_value();
+  }
+
+  // Compute density estimates; each thread processes every 'num_threads'th dataset
+  std::vector<kde_result> res(K);
+  auto process = [&data, &MIN, &MAX, &res, &plans, n, K, num_threads](size_t t) {
+    double *buf_in = (double*) fftw_malloc(n * sizeof(double));
+    double *buf_out = (double*) fftw_malloc(n * sizeof(double));
+    for (size_t j = t; j < K; j += num_threads) {
+      kde_one(data[j].data(), data[j].size(), n, MIN[j], MAX[j], plans, buf_in, buf_out, res[j]);
+    }
+    fftw_free(buf_in);
+    fftw_free(buf_out);
+  };
+  if (num_threads > 1) {
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < num_threads; ++t) {
+      threads.push_back(std::thread(process, t));
+    }
+    for (size_t t = 0; t < num_threads; ++t) {
+      threads[t].join();
+    }
+  } else {
+    process(0);
+  }
+  octave_quit();
+
+  // Build outputs
+  RowVector bandwidth(K);
+  Matrix density(n, K), xmesh(n, K);
+  for (size_t j = 0; j < K; ++j) {
+    if (!res[j].ok) {
+      error("could not solve for the bandwidth of dataset #%i", (int) j + 1);
+      return octave_value();
+    }
+    bandwidth(j) = res[j].bandwidth;
+    const double dx = (MAX[j] - MIN[j]) / (n - 1);
+    for (int k = 0; k < n; ++k) {
+      density(k, j) = res[j].density[k];
+      xmesh(k, j) = MIN[j] + k * dx;
+    }
+  }
+
+  octave_value_list retn;
+  retn(0) = octave_value(bandwidth);
+  if (nargout > 1) {
+    retn(1) = octave_value(density);
+  }
+  if (nargout > 2) {
+    retn(2) = octave_value(xmesh);
+  }
+  return retn;
+
+}
+
+/*
+
+## reference implementation, following kde()
+%!function [bandwidth, density] = kde_ref(data, n, MIN, MAX)
+%!  R = MAX - MIN; dx = R / (n - 1); xmesh = MIN + (0:n-1) * dx; N = length(data);
+%!  initial_data = histc(data, xmesh) / N;
+%!  weight = [1; 2*(exp(-i*(1:n-1)*pi/(2*n))).'];
+%!  a = real(weight .* fft([initial_data(1:2:end); initial_data(end:-2:2)]));
+%!  I = [1:n-1]'.^2; a2 = (a(2:end)/2).^2;
+%!  t_star = fzero(@(t) fixed_point(t, N, I, a2), [0, 0.1], optimset("TolX", eps));
+%!  a_t = a .* exp(-[0:n-1]'.^2*pi^2*t_star/2);
+%!  y = real(ifft(n*exp(i*(0:n-1)*pi/(2*n)).' .* a_t));
+%!  density = zeros(n, 1);
+%!  density(1:2:n) = y(1:n/2);
+%!  density(2:2:n) = y(n:-1:n/2+1);
+%!  density /= R;
+%!  bandwidth = sqrt(t_star) * R;
+%!endfunction
+%!function out = fixed_point(t, N, I, a2)
+%!  l = 7;
+%!  f = 2*pi^(2*l)*sum(I.^l.*a2.*exp(-I*pi^2*t));
+%!  for s = l-1:-1:2
+%!    K0 = prod([1:2:2*s-1])/sqrt(2*pi); const = (1+(1/2)^(s+1/2))/3;
+%!    time = (2*const*K0/N/f)^(2/(3+2*s));
+%!    f = 2*pi^(2*s)*sum(I.^s.*a2.*exp(-I*pi^2*time));
+%!  end
+%!  out = t - (2*N*sqrt(pi)*f)^(-2/5);
+%!endfunction
+
+%!test
+%!  randn("seed", 1);
+%!  data = [randn(100,1); randn(100,1)*2+35; randn(100,1)+55];
+%!  MIN = min(data) - 5; MAX = max(data) + 5;
+%!  [bandwidth, density, xmesh] = kdebatch(data, 2^14, MIN, MAX);
+%!  [bandwidth_ref, density_ref] = kde_ref(data, 2^14, MIN, MAX);
+%!  assert(bandwidth, bandwidth_ref, -1e-6);
+%!  assert(density, density_ref, 1e-6 * max(density_ref));
+%!  assert(xmesh, MIN + (0:2^14-1)' * (MAX - MIN) / (2^14 - 1), -1e-12);
+
+%!test
+%!  randn("seed", 2);
+%!  data = [randn(1000, 4), 3 + 2*randn(1000, 4)];
+%!  [bandwidth, density, xmesh] = kdebatch(data, 2^12);
+%!  assert(size(bandwidth), [1, 8]);
+%!  assert(size(density), [2^12, 8]);
+%!  for j = 1:8
+%!    [bandwidth_j, density_j, xmesh_j] = kdebatch(data(:, j), 2^12, [], [], 1);
+%!    assert(bandwidth(j), bandwidth_j);
+%!    assert(density(:, j), density_j);
+%!    assert(xmesh(:, j), xmesh_j);
+%!    assert(sum(density(:, j)) * (xmesh(2, j) - xmesh(1, j)), 1, 1e-2);
+%!  endfor
+%!  bandwidth_c = kdebatch(num2cell(data, 1), 2^12);
+%!  assert(bandwidth_c, bandwidth);
+
+*/
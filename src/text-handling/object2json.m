@@ -17,6 +17,7 @@
 
 ## -*- texinfo -*-
 ## @deftypefn {Function File} {@var{json} =} object2json ( @var{object} )
+## @deftypefnx{Function File} {} object2json ( @var{object}, @var{filename} )
 ##
 ## This function returns a valid json string that will describe @var{object}
 ## The string will be in a compact form (i.e. no spaces or line breaks)
@@ -62,6 +63,14 @@
 ## If they're valid in JSON it will keep them if not they'll be
 ## escaped so they can become valid
 ##
+## If @var{filename} is given, the json string is written to that file
+## instead of being returned.
+##
+## If the @command{object2json_native()} module is built, it is used to
+## write the json string; it writes to a growing buffer (or directly to
+## @var{filename}) instead of concatenating strings recursively, and writes
+## numbers with the fewest digits which read back to the same value.
+##
 ## @end deftypefn
 
 ## object2json.m
@@ -70,7 +79,34 @@
 ## 2011-01-23 Added support for especial chars and escaped sequences
 ## 2011-04-01 Fixed error: Column vectors not working correctly
 
-function json=object2json(object)
+function json=object2json(object, filename)
+
+  ## Check input
+  assert(nargin == 1 || (nargin == 2 && ischar(filename)), "%s: invalid arguments", funcName);
+
+  ## Use native JSON writer if available
+  if(exist("object2json_native") == 3)
+    if(nargin > 1)
+      object2json_native(object, filename);
+    else
+      json=object2json_native(object);
+    endif
+    return
+  endif
+
+  json=object2json_m(object);
+  if(nargin > 1)
+    fid=fopen(filename, "w");
+    assert(fid >= 0, "%s: could not open '%s' for writing", funcName, filename);
+    fputs(fid, json);
+    fclose(fid);
+    clear json
+  endif
+
+endfunction
+
+## Recursive JSON writer, used if object2json_native() is not built
+function json=object2json_m(object)
 
   s=size(object);
   if(all(s==1))
@@ -83,7 +119,7 @@ function json=object2json(object)
         json=['"',fun.function,'"'];
       case 'struct'
         fields=fieldnames(object);
-        results=cellfun(@object2json,struct2cell(object),"UniformOutput",false);
+        results=cellfun(@object2json_m,struct2cell(object),"UniformOutput",false);
         json="{";
         if(numel(fields)>1)
           sep=",";
@@ -99,7 +135,7 @@ function json=object2json(object)
         json(end+1)="}";
       case 'cell'
         ## We dereference the cell and use it as a new value
-        json=object2json(object{1});
+        json=object2json_m(object{1});
       case 'double'
         if(isreal(object))
           json=num2str(object, 16);
@@ -125,7 +161,7 @@ function json=object2json(object)
     if(numel(s)>2)
       json="[";
       for(tmp=1:s(1))
-        json=[json,sep,object2json(reshape(object(tmp,:),s(2:end)))];
+        json=[json,sep,object2json_m(reshape(object(tmp,:),s(2:end)))];
         sep=",";
       endfor
       json(end+1)="]";
@@ -146,7 +182,7 @@ function json=object2json(object)
         else
           json="[";
           for(tmp=1:s(2))
-            json=[json,sep,object2json(object(1,tmp))];
+            json=[json,sep,object2json_m(object(1,tmp))];
             sep=",";
           endfor
           json(end+1)="]";
@@ -155,7 +191,7 @@ function json=object2json(object)
         ## Object is a column
         json="[";
         for(tmp=1:s(1))
-          json=[json,sep,"[",object2json(object(tmp,1)),"]"];
+          json=[json,sep,"[",object2json_m(object(tmp,1)),"]"];
           sep=",";
         endfor
         json(end+1)="]";
@@ -163,7 +199,7 @@ function json=object2json(object)
         ## Object is a 2D matrix
         json="[";
         for(tmp=1:s(1))
-          json=[json,sep,object2json(object(tmp,:))];
+          json=[json,sep,object2json_m(object(tmp,:))];
           sep=",";
         endfor
         json(end+1)="]";
@@ -197,3 +233,23 @@ endfunction
 %!assert(object2json({1.234, 2.345}), '[1.234,2.345]')
 %!assert(object2json({1.234, 2.345, "abcd"}), '[1.234,2.345,"abcd"]')
 %!assert(object2json(struct("abcd", 1.234)), '{"abcd":1.234}')
+%!assert(object2json([1, 2; 3, 4]), '[[1,2],[3,4]]')
+%!assert(object2json([1; 2]), '[[1],[2]]')
+%!assert(object2json(1 + 2i), '{"real":1,"imag":2}')
+%!assert(object2json(complex(1, 0)), '{"real":1,"imag":0}')
+%!assert(object2json(int32(1)), '"int32"')
+%!assert(object2json(''), '[]')
+%!assert(object2json('a"b/c'), '"a\"b\/c"')
+
+%!test
+%!  x = struct("a", [1, 2; 3, 4], "b", {{"xyz", 1 + 2i}});
+%!  filename = tempname(tempdir);
+%!  unwind_protect
+%!    object2json(x, filename);
+%!    fid = fopen(filename, "r");
+%!    json = fread(fid, Inf, "char=>char")';
+%!    fclose(fid);
+%!  unwind_protect_cleanup
+%!    unlink(filename);
+%!  end_unwind_protect
+%!  assert(json, object2json(x));
@@ -0,0 +1,582 @@
+//
+// Copyright (C) 2026 Karl Wette
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with with program; see the file COPYING. If not, write to the
+// Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+// MA  02111-1307  USA
+//
+
+#include <cctype>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <octave/oct.h>
+#if OCTAVE_VERSION_HEX >= 0x040200
+#include <octave/interpreter.h>
+#else
+#include <octave/toplev.h>
+#endif
+#include <octave/Cell.h>
+#include <octave/oct-map.h>
+#include <octave/parse.h>
+
+#if OCTAVE_VERSION_HEX <= 0x030204
+#define octave_map Octave_map
+#endif
+
+static const char *const object2json_native_usage = "-*- texinfo -*- \n\
+@deftypefn {Loadable Function} {@var{json} =} object2json_native ( @var{object} )\n\
+@deftypefnx{Loadable Function} {} object2json_native ( @var{object}, @var{filename} )\n\
+\n\
+Return a JSON string describing @var{object}, or write it to the file @var{filename}; \
+used by @command{object2json()}, whose documentation describes the output format.\n\
+\n\
+The JSON is written to a growing buffer, or through a buffer directly to the file, \
+and numbers are formatted with the fewest digits which read back to the same value.\n\
+\n\
+@end deftypefn";
+
+// Buffered JSON output, to a string or to a file
+class json_writer {
+
+public:
+
+  json_writer(FILE *f) : fp(f) {
+    buf.reserve(buf_flush_size + 1024);
+  }
+
+  void put(char c) {
+    buf.push_back(c);
+  }
+
+  void put(const char *s, size_t n) {
+    buf.append(s, n);
+  }
+
+  void put(const std::string& s) {
+    buf.append(s);
+  }
+
+  // Flush buffer to file if full
+  bool maybe_flush() {
+    return (fp == 0 || buf.size() < buf_flush_size) ? true : flush();
+  }
+
+  bool flush() {
+    if (fp != 0 && !buf.empty()) {
+      if (fwrite(buf.data(), 1, buf.size(), fp) != buf.size()) {
+        return false;
+      }
+      buf.clear();
+    }
+    return true;
+  }
+
+  const std::string& str() const {
+    return buf;
+  }
+
+private:
+
+  static const size_t buf_flush_size = 1 << 20;
+  FILE *fp;
+  std::string buf;
+
+};
+
+// Format a real number, as num2str() would but with the fewest digits which read back to the same value
+static void write_double(json_writer& w, const double x) {
+  if (lo_ieee_is_NA(x)) {
+    w.put("NA", 2);
+  } else if (std::isnan(x)) {
+    w.put("NaN", 3);
+  } else if (std::isinf(x)) {
+    if (x > 0) {
+      w.put("Inf", 3);
+    } else {
+      w.put("-Inf", 4);
+    }
+  } else {
+    char s[32];
+    int n = 0;
+    for (int prec = 15; prec <= 17; ++prec) {
+      n = snprintf(s, sizeof(s), "%.*g", prec, x);
+      if (prec == 17 || std::strtod(s, 0) == x) {
+        break;
+      }
+    }
+    w.put(s, n);
+  }
+}
+
+static void write_complex(json_writer& w, const Complex& z) {
+  w.put("{\"real\":", 8);
+  write_double(w, z.real());
+  w.put(",\"imag\":", 8);
+  write_double(w, z.imag());
+  w.put('}');
+}
+
+// Undo the escape sequences of double-quoted strings, as undo_string_escapes() does
+static void undo_escapes(const char *s, size_t n, std::string& out) {
+  out.clear();
+  for (size_t i = 0; i < n; ++i) {
+    switch (s[i]) {
+    case '\0': out += "\\0"; break;
+    case '\a': out += "\\a"; break;
+    case '\b': out += "\\b"; break;
+    case '\f': out += "\\f"; break;
+    case '\n': out += "\\n"; break;
+    case '\r': out += "\\r"; break;
+    case '\t': out += "\\t"; break;
+    case '\v': out += "\\v"; break;
+    case '\\': out += "\\\\"; break;
+    case '"': out += "\\\""; break;
+    default: out += s[i];
+    }
+  }
+}
+
+// Whether s[i..n) starts a valid JSON escape sequence (following a backslash)
+static bool is_json_escape(const char *s, size_t i, size_t n) {
+  if (i >= n) {
+    return false;
+  }
+  if (std::strchr("\"\\/bfnrt", s[i]) != 0 && s[i] != '\0') {
+    return true;
+  }
+  if (s[i] == 'u' && i + 4 < n) {
+    for (size_t j = i + 1; j <= i + 4; ++j) {
+      if (!std::isxdigit((unsigned char) s[j])) {
+        return false;
+      }
+    }
+    return true;
+  }
+  return false;
+}
+
+// Write a string, keeping valid JSON escape sequences, escaping unescaped
+// quotes and slashes, and escaping backslashes which do not start a valid
+// JSON escape sequence
+static void write_string(json_writer& w, const char *s0, size_t n0, bool dq, std::string& tmp) {
+  const char *s = s0;
+  size_t n = n0;
+  if (dq) {
+    undo_escapes(s0, n0, tmp);
+    s = tmp.data();
+    n = tmp.size();
+  }
+  w.put('"');
+  size_t i = 0;
+  while (i < n) {
+    if (s[i] == '\\') {
+      size_t r = 0;
+      while (i + r < n && s[i + r] == '\\') {
+        ++r;
+      }
+      if (i + r < n && (s[i + r] == '"' || s[i + r] == '/')) {
+        // run of backslashes followed by a quote or slash: escape it if not already
+        w.put(s + i, r);
+        if (r % 2 == 0) {
+          w.put('\\');
+        }
+        w.put(s[i + r]);
+        i += r + 1;
+      } else {
+        // lone backslash at end of run: escape it if it does not start a valid sequence
+        if (r % 2 == 1 && !is_json_escape(s, i + r, n)) {
+          w.put('\\');
+        }
+        w.put(s + i, r);
+        i += r;
+      }
+    } else {
+      if (s[i] == '"' || s[i] == '/') {
+        w.put('\\');
+      }
+      w.put(s[i]);
+      ++i;
+    }
+  }
+  w.put('"');
+}
+
+// Closes a file when it goes out of scope, e.g. if an exception is thrown
+class file_closer {
+
+public:
+
+  file_closer(FILE *f) : fp(f) { }
+
+  ~file_closer() {
+    if (fp != 0) {
+      fclose(fp);
+    }
+  }
+
+  int close() {
+    const int status = fclose(fp);
+    fp = 0;
+    return status;
+  }
+
+private:
+
+  FILE *fp;
+
+};
+
+// Array layout, as an offset and stride into the linear elements, and dimensions
+struct array_view {
+  octave_idx_type offset, stride;
+  std::vector<octave_idx_type> dims;
+};
+
+class json_encoder {
+
+public:
+
+  json_encoder(json_writer& w) : w(w) { }
+
+  bool write_value(const octave_value& v);
+
+private:
+
+  json_writer& w;
+  std::string tmp;
+
+  template<class E> bool write_array(const array_view& a, E& e);
+
+};
+
+// Writers of elements of specific types of arrays
+struct real_elems {
+  const double *x;
+  bool is_char() const { return false; }
+  bool write(json_encoder&, json_writer& w, octave_idx_type i) { write_double(w, x[i]); return true; }
+};
+struct complex_elems {
+  const Complex *z;
+  bool is_char() const { return false; }
+  bool write(json_encoder&, json_writer& w, octave_idx_type i) {
+    // Elements of complex arrays with zero imaginary part are indexed as real numbers;
+    // complex scalars are written by json_encoder::write_value() instead
+    if (z[i].imag() == 0) {
+      write_double(w, z[i].real());
+    } else {
+      write_complex(w, z[i]);
+    }
+    return true;
+  }
+};
+struct char_elems {
+  const char *c;
+  bool dq;
+  std::string *tmp;
+  bool is_char() const { return true; }
+  bool write(json_encoder&, json_writer& w, octave_idx_type i) { write_string(w, c + i, 1, dq, *tmp); return true; }
+  void write_row(json_writer& w, octave_idx_type offset, octave_idx_type stride, octave_idx_type n) {
+    std::string row(n, ' ');
+    for (octave_idx_type j = 0; j < n; ++j) {
+      row[j] = c[offset + j * stride];
+    }
+    write_string(w, row.data(), row.size(), dq, *tmp);
+  }
+};
+struct cell_elems {
+  const Cell *c;
+  bool is_char() const { return false; }
+  bool write(json_encoder& e, json_writer&, octave_idx_type i) { return e.write_value((*c)(i)); }
+};
+struct struct_elems {
+  const octave_map *m;
+  string_vector keys;
+  std::vector<Cell> fields;
+  bool is_char() const { return false; }
+  bool write(json_encoder& e, json_writer& w, octave_idx_type i) {
+    w.put('{');
+    for (octave_idx_type k = 0; k < keys.numel(); ++k) {
+      if (k > 0) {
+        w.put(',');
+      }
+      w.put('"');
+      w.put(keys(k));
+      w.put("\":", 2);
+      if (!e.write_value(fields[k](i))) {
+        return false;
+      }
+    }
+    w.put('}');
+    return true;
+  }
+};
+struct class_elems {
+  std::string name;
+  bool is_char() const { return false; }
+  bool write(json_encoder&, json_writer& w, octave_idx_type) { w.put('"'); w.put(name); w.put('"'); return true; }
+};
+
+// Write an array as nested JSON arrays, following object2json(): rows map to arrays,
+// elements of columns to single-element arrays, and N-dimensional arrays to arrays
+// of their slices along the first dimension
+template<class E> static void write_char_row(E&, json_writer&, const array_view&) { }
+template<> void write_char_row<char_elems>(char_elems& e, json_writer& w, const array_view& a) {
+  e.write_row(w, a.offset, a.stride, a.dims[1]);
+}
+
+template<class E> bool json_encoder::write_array(const array_view& a, E& e) {
+  bool scalar = true;
+  for (size_t k = 0; k < a.dims.size(); ++k) {
+    scalar = scalar && (a.dims[k] == 1);
+  }
+  if (scalar) {
+    return e.write(*this, w, a.offset);
+  }
+  if (!w.maybe_flush()) {
+    return false;
+  }
+  if (a.dims.size() > 2) {
+    w.put('[');
+    array_view b;
+    b.stride = a.stride * a.dims[0];
+    b.dims.assign(a.dims.begin() + 1, a.dims.end());
+    for (octave_idx_type i = 0; i < a.dims[0]; ++i) {
+      if (i > 0) {
+        w.put(',');
+      }
+      b.offset = a.offset + i * a.stride;
+      if (!write_array(b, e)) {
+        return false;
+      }
+    }
+    w.put(']');
+    return true;
+  }
+  const octave_idx_type nr = a.dims[0], nc = a.dims[1];
+  if (nr == 1) {
+    if (e.is_char()) {
+      write_char_row(e, w, a);
+      return true;
+    }
+    w.put('[');
+    for (octave_idx_type j = 0; j < nc; ++j) {
+      if (j > 0) {
+        w.put(',');
+      }
+      if (!e.write(*this, w, a.offset + j * a.stride)) {
+        return false;
+      }
+    }
+    w.put(']');
+  } else if (nc == 1) {
+    w.put('[');
+    for (octave_idx_type i = 0; i < nr; ++i) {
+      if (i > 0) {
+        w.put(',');
+      }
+      w.put('[');
+      if (!e.write(*this, w, a.offset + i * a.stride)) {
+        return false;
+      }
+      w.put(']');
+    }
+    w.put(']');
+  } else {
+    w.put('[');
+    array_view b;
+    b.stride = a.stride * nr;
+    b.dims.push_back(1);
+    b.dims.push_back(nc);
+    for (octave_idx_type i = 0; i < nr; ++i) {
+      if (i > 0) {
+        w.put(',');
+      }
+      b.offset = a.offset + i * a.stride;
+      if (!write_array(b, e)) {
+        return false;
+      }
+    }
+    w.put(']');
+  }
+  return true;
+}
+
+bool json_encoder::write_value(const octave_value& v) {
+
+  array_view a;
+  a.offset = 0;
+  a.stride = 1;
+  const dim_vector dv = v.dims();
+  for (int k = 0; k < dv.ndims(); ++k) {
+    a.dims.push_back(dv(k));
+  }
+
+  if (v.is_function_handle()) {
+
+    // For a function handle we will only print the name
+#if OCTAVE_VERSION_HEX >= 0x040400
+    const octave_value_list r = octave::feval("functions", octave_value_list(v), 1);
+#else
+    const octave_value_list r = feval("functions", octave_value_list(v), 1);
+#endif
+    const std::string name = r(0).map_value().contents("function")(0).string_value();
+    w.put('"');
+    w.put(name);
+    w.put('"');
+    return true;
+
+  } else if (v.is_map() && !v.is_object()) {
+    const octave_map m = v.map_value();
+    struct_elems e;
+    e.m = &m;
+    e.keys = m.keys();
+    for (octave_idx_type k = 0; k < e.keys.numel(); ++k) {
+      e.fields.push_back(m.contents(e.keys(k)));
+    }
+    return write_array(a, e);
+  } else if (v.is_cell()) {
+    const Cell c = v.cell_value();
+    cell_elems e;
+    e.c = &c;
+    return write_array(a, e);
+  } else if (v.is_string()) {
+    const charNDArray c = v.char_array_value();
+    char_elems e;
+    e.c = c.data();
+    e.dq = v.is_dq_string();
+    e.tmp = &tmp;
+    return write_array(a, e);
+  } else if (v.class_name() == "double" && v.is_complex_type()) {
+    const ComplexNDArray z = v.complex_array_value();
+    if (z.numel() == 1) {
+      // A complex scalar is written as complex, even if its imaginary part is zero
+      write_complex(w, z(0));
+      return true;
+    }
+    complex_elems e;
+    e.z = z.data();
+    return write_array(a, e);
+  } else if (v.class_name() == "double") {
+    const NDArray x = v.array_value();
+    real_elems e;
+    e.x = x.data();
+    return write_array(a, e);
+  } else {
+
+    // We don't know what is it so we'll put the class name
+    class_elems e;
+    e.name = v.class_name();
+    if (v.is_object()) {
+      a.dims.assign(2, 1);
+    }
+    return write_array(a, e);
+
+  }
+
+}
+
+DEFUN_DLD( object2json_native, args, nargout, object2json_native_usage ) {
+
+  // Prevent octave from crashing ...
+#if OCTAVE_VERSION_HEX < 0x040400
+  octave_exit = ::_Exit;
+#endif
+
+  // Check input and output
+  if (args.length() < 1 || args.length() > 2 || nargout > 1) {
+    print_usage();
+    return octave_value();
+  }
+  if (args.length() > 1 && (!args(1).is_string() || nargout > 0)) {
+    print_usage();
+    return octave_value();
+  }
+
+  // Write JSON to a string
+  if (args.length() == 1) {
+    json_writer w(0);
+    json_encoder e(w);
+    e.write_value(args(0));
+    return octave_value(w.str());
+  }
+
+  // Write JSON to a file
+  const std::string filename = args(1).string_value();
+  FILE *fp = fopen(filename.c_str(), "wb");
+  if (fp == 0) {
+    error("could not open '%s' for writing: %s", filename.c_str(), std::strerror(errno));
+    return octave_value();
+  }
+  file_closer closer(fp);
+  json_writer w(fp);
+  json_encoder e(w);
+  const bool ok = e.write_value(args(0)) && w.flush();
+  if (closer.close() != 0 || !ok) {
+    error("could not write to '%s'", filename.c_str());
+    return octave_value();
+  }
+
+  return octave_value();
+
+}
+
+/*
+
+%!assert(object2json_native({1.234, 2.345}), '[1.234,2.345]')
+%!assert(object2json_native({1.234, 2.345, "abcd"}), '[1.234,2.345,"abcd"]')
+%!assert(object2json_native(struct("abcd", 1.234)), '{"abcd":1.234}')
+%!assert(object2json_native(struct("a", {1, 2}, "b", "x")), '[{"a":1,"b":"x"},{"a":2,"b":"x"}]')
+%!assert(object2json_native(struct()), '{}')
+%!assert(object2json_native([1, 2; 3, 4]), '[[1,2],[3,4]]')
+%!assert(object2json_native([1; 2]), '[[1],[2]]')
+%!assert(object2json_native(reshape(1:8, 2, 2, 2)), '[[[1,5],[3,7]],[[2,6],[4,8]]]')
+%!assert(object2json_native(zeros(0, 3)), '[]')
+%!assert(object2json_native(""), '[]')
+%!assert(object2json_native(1 + 2i), '{"real":1,"imag":2}')
+%!assert(object2json_native([1 + 2i, 3]), '[{"real":1,"imag":2},3]')
+%!assert(object2json_native(complex(1, 0)), '{"real":1,"imag":0}')
+%!assert(object2json_native({complex(1, 0)}), '{"real":1,"imag":0}')
+%!assert(object2json_native([0.1, 1/3, 1e20, -0.5]), '[0.1,0.3333333333333333,1e+20,-0.5]')
+%!assert(object2json_native(0.1 + 0.2), '0.30000000000000004')
+%!assert(str2double(object2json_native(pi)), pi)
+%!assert(object2json_native([NaN, Inf, -Inf]), '[NaN,Inf,-Inf]')
+%!assert(object2json_native(int32([1, 2])), '["int32","int32"]')
+%!assert(object2json_native(true), '"logical"')
+%!assert(object2json_native(single(1)), '"single"')
+%!assert(object2json_native(@sin), '"sin"')
+%!assert(object2json_native(["ab"; "cd"]), '["ab","cd"]')
+%!assert(object2json_native('a"b/c'), '"a\"b\/c"')
+%!assert(object2json_native('a\"b\n\q'), '"a\"b\n\\q"')
+%!assert(object2json_native("a\nb"), '"a\nb"')
+
+%!test
+%!  x = struct("a", rand(10, 20), "b", {{"xyz", 1 + 2i}});
+%!  filename = tempname(tempdir);
+%!  unwind_protect
+%!    object2json_native(x, filename);
+%!    fid = fopen(filename, "r");
+%!    json = fread(fid, Inf, "char=>char")';
+%!    fclose(fid);
+%!  unwind_protect_cleanup
+%!    unlink(filename);
+%!  end_unwind_protect
+%!  assert(json, object2json_native(x));
+
+*/